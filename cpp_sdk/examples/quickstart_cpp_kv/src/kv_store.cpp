@@ -1,7 +1,6 @@
 #include "kv_store.h" // Local header
 
 // SDK Headers
-#include <spacetimedb/sdk/spacetimedb_sdk_reducer.h>
 #include <spacetimedb/sdk/database.h>
 #include <spacetimedb/sdk/table.h>
 #include <spacetimedb/abi/spacetimedb_abi.h> // For direct ABI calls like _console_log
@@ -9,13 +8,9 @@
 // Standard Library
 #include <string>
 #include <vector>
-#include <stdexcept> // For std::runtime_error (used by SDK components)
+#include <optional>
 #include <cstring>   // For std::strlen in log_message_abi
 
-// The _spacetimedb_sdk_init() function is defined in spacetimedb_sdk_reducer.h
-// and will be exported. The host calls it to initialize the SDK, including the
-// global database instance needed by the ReducerContext.
-
 namespace spacetimedb_quickstart {
 
 // KeyValue BSATN implementation
@@ -29,16 +24,6 @@ namespace spacetimedb_quickstart {
 //     value_str = reader.read_string();
 // }
 
-// Register the KeyValue table with the SDK's global registry.
-// "key_str" is declared as the primary key field.
-// The SDK's table registration currently assumes if a PK field name is provided,
-// its column index is 0 (i.e., it's the first field serialized).
-// SPACETIMEDB_REGISTER_TABLE(spacetimedb_quickstart::KeyValue, "kv_pairs", "key_str"); // Removed as per plan
-
-SPACETIMEDB_TABLE(spacetimedb_quickstart::KeyValue, "kv_pairs", true /* is_public */);
-SPACETIMEDB_PRIMARY_KEY("kv_pairs", "id"); // Changed PK to "id"
-SPACETIMEDB_INDEX("kv_pairs", "idx_key_str", { "key_str" });
-
 // Helper for logging from reducers via the raw ABI
 static void log_message_abi(uint8_t level, const std::string& context_info, const std::string& message) {
     std::string full_message = "[" + context_info + "] " + message;
@@ -53,106 +38,136 @@ static void log_message_abi(uint8_t level, const std::string& context_info, cons
                  full_message.length());
 }
 
+// Logs a failed SDK call and passes its error on as the reducer's result, which makes
+// __call_reducer__ report the call as failed.
+static spacetimedb::sdk::ReducerResult log_failure(const std::string& reducer_name, const spacetimedb::sdk::Error& error) {
+    log_message_abi(LOG_LEVEL_ERROR, reducer_name, "Error: " + error.message);
+    return error;
+}
+
 // Reducer Implementations
+// The non-throwing try_ calls keep the module buildable with -fno-exceptions
+// (SPACETIMEDB_NO_EXCEPTIONS); failures are returned instead of thrown.
 
-void kv_put(spacetimedb::sdk::ReducerContext& ctx, const std::string& key, const std::string& value) {
+spacetimedb::sdk::ReducerResult kv_put(spacetimedb::sdk::ReducerContext& ctx, const std::string& key, const std::string& value) {
     std::string reducer_name = "kv_put";
-    try {
-        auto kv_table = ctx.db().get_table<KeyValue>("kv_pairs");
-
-        // Upsert logic based on key_str (column index 1)
-        // Primary key 'id' (column index 0) is auto-incrementing.
-        uint32_t key_str_col_idx = 1;
-        uint32_t id_pk_col_idx = 0;
-
-        std::vector<KeyValue> existing_rows = kv_table.find_by_col_eq(key_str_col_idx, key);
-        if (!existing_rows.empty()) {
-            // key_str is unique, so there should be at most one row.
-            kv_table.delete_by_col_eq(id_pk_col_idx, existing_rows[0].id);
-        }
+    auto kv_table = ctx.db().try_get_table<KeyValue>();
+    if (!kv_table) {
+        return log_failure(reducer_name, kv_table.error());
+    }
 
-        KeyValue row_to_insert(key, value); // id is 0 initially
-        kv_table.insert(row_to_insert); // id will be auto-generated and updated in row_to_insert
+    // Update in place through the unique index on key_str when the key exists, insert otherwise.
+    // Index ids are stable for the module's lifetime, so resolve it once.
+    static std::optional<uint32_t> key_str_idx;
+    if (!key_str_idx) {
+        auto resolved = kv_table->try_index_id("kv_pairs_key_str_idx_btree");
+        if (!resolved) {
+            return log_failure(reducer_name, resolved.error());
+        }
+        key_str_idx = resolved.value();
+    }
 
-        std::string log_msg = "Successfully put K-V: (id: " + std::to_string(row_to_insert.id) + ", key: " + key + ", value: " + value + ")";
-        log_message_abi(LOG_LEVEL_INFO, reducer_name, log_msg);
+    auto existing = kv_table->try_find_unique(*key_str_idx, key);
+    if (!existing) {
+        return log_failure(reducer_name, existing.error());
+    }
 
-    } catch (const std::runtime_error& e) {
-        std::string error_msg = "Error: " + std::string(e.what());
-        log_message_abi(LOG_LEVEL_ERROR, reducer_name, error_msg);
-        // The reducer macro will catch this exception and return an error code to the host.
-        throw; // Re-throw to be caught by the reducer macro wrapper
+    KeyValue row_to_insert(key, value);
+    if (existing->has_value()) {
+        // Keep the row's id: a zero id would make the host generate a new one and rewrite the primary key.
+        row_to_insert.id = existing.value()->id;
+        auto updated = kv_table->try_update_by_unique(*key_str_idx, row_to_insert);
+        if (!updated) {
+            return log_failure(reducer_name, updated.error());
+        }
+    } else {
+        auto inserted = kv_table->try_insert(row_to_insert); // id is 0, so the host generates it and writes it back
+        if (!inserted) {
+            return log_failure(reducer_name, inserted.error());
+        }
     }
+
+    std::string log_msg = "Successfully put K-V: (id: " + std::to_string(row_to_insert.id) + ", key: " + key + ", value: " + value + ")";
+    log_message_abi(LOG_LEVEL_INFO, reducer_name, log_msg);
+    return {};
 }
 
-void kv_get(spacetimedb::sdk::ReducerContext& ctx, const std::string& key) {
+spacetimedb::sdk::ReducerResult kv_get(spacetimedb::sdk::ReducerContext& ctx, const std::string& key) {
     std::string reducer_name = "kv_get";
-    try {
-        auto kv_table = ctx.db().get_table<KeyValue>("kv_pairs");
-        uint32_t key_str_col_idx = 1; // Find by key_str (column index 1)
-
-        std::vector<KeyValue> rows = kv_table.find_by_col_eq(key_str_col_idx, key);
-
-        if (!rows.empty()) {
-            // key_str is unique, so there should be at most one row.
-            const auto& row = rows[0];
-            std::string log_msg = "Found by key_str '" + key + "': (id: " + std::to_string(row.id) + ", key: " + row.key_str + ", value: " + row.value_str + ")";
-            log_message_abi(LOG_LEVEL_INFO, reducer_name, log_msg);
-        } else {
-            std::string log_msg = "No entry found for key_str: " + key;
-            log_message_abi(LOG_LEVEL_INFO, reducer_name, log_msg);
-        }
-    } catch (const std::runtime_error& e) {
-        std::string error_msg = "Error: " + std::string(e.what());
-        log_message_abi(LOG_LEVEL_ERROR, reducer_name, error_msg);
-        throw;
+    auto kv_table = ctx.db().try_get_table<KeyValue>();
+    if (!kv_table) {
+        return log_failure(reducer_name, kv_table.error());
+    }
+    uint32_t key_str_col_idx = 1; // Find by key_str (column index 1)
+
+    auto rows = kv_table->try_find_by_col_eq(key_str_col_idx, key);
+    if (!rows) {
+        return log_failure(reducer_name, rows.error());
+    }
+
+    if (!rows->empty()) {
+        // key_str is unique, so there should be at most one row.
+        const auto& row = rows.value()[0];
+        std::string log_msg = "Found by key_str '" + key + "': (id: " + std::to_string(row.id) + ", key: " + row.key_str + ", value: " + row.value_str + ")";
+        log_message_abi(LOG_LEVEL_INFO, reducer_name, log_msg);
+    } else {
+        std::string log_msg = "No entry found for key_str: " + key;
+        log_message_abi(LOG_LEVEL_INFO, reducer_name, log_msg);
     }
+    return {};
 }
 
-void kv_del(spacetimedb::sdk::ReducerContext& ctx, const std::string& key) {
+spacetimedb::sdk::ReducerResult kv_del(spacetimedb::sdk::ReducerContext& ctx, const std::string& key) {
     std::string reducer_name = "kv_del";
-    try {
-        auto kv_table = ctx.db().get_table<KeyValue>("kv_pairs");
-        uint32_t key_str_col_idx = 1; // Delete by key_str (column index 1)
-
-        uint32_t deleted_count = kv_table.delete_by_col_eq(key_str_col_idx, key);
-
-        if (deleted_count > 0) {
-            std::string log_msg = "Successfully deleted " + std::to_string(deleted_count) + " item(s) for key_str: " + key;
-            log_message_abi(LOG_LEVEL_INFO, reducer_name, log_msg);
-        } else {
-            std::string log_msg = "No items found to delete for key_str: " + key;
-            log_message_abi(LOG_LEVEL_INFO, reducer_name, log_msg);
-        }
-    } catch (const std::runtime_error& e) {
-        std::string error_msg = "Error: " + std::string(e.what());
-        log_message_abi(LOG_LEVEL_ERROR, reducer_name, error_msg);
-        throw;
+    auto kv_table = ctx.db().try_get_table<KeyValue>();
+    if (!kv_table) {
+        return log_failure(reducer_name, kv_table.error());
+    }
+    uint32_t key_str_col_idx = 1; // Delete by key_str (column index 1)
+
+    auto deleted_count = kv_table->try_delete_by_col_eq(key_str_col_idx, key);
+    if (!deleted_count) {
+        return log_failure(reducer_name, deleted_count.error());
     }
+
+    if (deleted_count.value() > 0) {
+        std::string log_msg = "Successfully deleted " + std::to_string(deleted_count.value()) + " item(s) for key_str: " + key;
+        log_message_abi(LOG_LEVEL_INFO, reducer_name, log_msg);
+    } else {
+        std::string log_msg = "No items found to delete for key_str: " + key;
+        log_message_abi(LOG_LEVEL_INFO, reducer_name, log_msg);
+    }
+    return {};
 }
 
-// Register Reducers with the SDK.
-// The types listed (e.g., const std::string&) must match the C++ function signature after ReducerContext.
-// The actual exported WASM function name will be "kv_put", "kv_get", "kv_del".
-SPACETIMEDB_REDUCER(spacetimedb_quickstart::kv_put, const std::string&, const std::string&);
-SPACETIMEDB_REDUCER(spacetimedb_quickstart::kv_get, const std::string&);
-SPACETIMEDB_REDUCER(spacetimedb_quickstart::kv_del, const std::string&);
-
-// Schema registrations for reducers
-SPACETIMEDB_REDUCER("kv_put", spacetimedb_quickstart::kv_put,
-    { SPACETIMEDB_REDUCER_PARAM("key", SpacetimeDb::CoreType::String),
-      SPACETIMEDB_REDUCER_PARAM("value", SpacetimeDb::CoreType::String) },
-    std::string, std::string
-);
+} // namespace spacetimedb_quickstart
 
-SPACETIMEDB_REDUCER("kv_get", spacetimedb_quickstart::kv_get,
-    { SPACETIMEDB_REDUCER_PARAM("key", SpacetimeDb::CoreType::String) },
-    std::string
+// Register the KeyValue table; "id" is the auto-increment primary key and key_str gets its own
+// index. Like the type registration in kv_store.h, these expand at global scope.
+SPACETIMEDB_TABLE(spacetimedb_quickstart::KeyValue, "kv_pairs", true /* is_public */)
+SPACETIMEDB_PRIMARY_KEY("kv_pairs", "id")
+SPACETIMEDB_INDEX("kv_pairs", "idx_key_str", { "key_str" })
+
+// Register Reducers with the SDK; __call_reducer__ dispatches to them by id. The macros name
+// the function unqualified, so it is brought into the global scope first.
+// The types listed after the schema (e.g. const std::string&) must match the C++ function
+// signature after ReducerContext.
+using spacetimedb_quickstart::kv_put;
+using spacetimedb_quickstart::kv_get;
+using spacetimedb_quickstart::kv_del;
+
+SPACETIMEDB_REDUCER_NAMED("kv_put", kv_put,
+    ({ SPACETIMEDB_REDUCER_PARAM("key", SpacetimeDb::CoreType::String),
+      SPACETIMEDB_REDUCER_PARAM("value", SpacetimeDb::CoreType::String) }),
+    const std::string&, const std::string&
 );
 
-SPACETIMEDB_REDUCER("kv_del", spacetimedb_quickstart::kv_del,
-    { SPACETIMEDB_REDUCER_PARAM("key", SpacetimeDb::CoreType::String) },
-    std::string
+SPACETIMEDB_REDUCER_NAMED("kv_get", kv_get,
+    ({ SPACETIMEDB_REDUCER_PARAM("key", SpacetimeDb::CoreType::String) }),
+    const std::string&
 );
 
-} // namespace spacetimedb_quickstart
+SPACETIMEDB_REDUCER_NAMED("kv_del", kv_del,
+    ({ SPACETIMEDB_REDUCER_PARAM("key", SpacetimeDb::CoreType::String) }),
+    const std::string&
+);
@@ -10,6 +10,7 @@
 #include <spacetimedb/bsatn/bsatn.h> // Assuming bsatn.h is under spacetimedb/bsatn path
 // #include <spacetimedb/sdk/spacetimedb_sdk_table_registry.h> // Removed as per plan
 #include <spacetimedb/sdk/reducer_context.h>
+#include <spacetimedb/sdk/result.h> // For ReducerResult
 #include <spacetimedb/macros.h> // Added as per plan
 
 #include <string>
@@ -46,27 +47,27 @@ struct KeyValue { // Removed inheritance from BsatnSerializable
     }
 };
 
-#define KEY_VALUE_FIELDS(XX) \
-    XX(uint64_t, id, false, false) \
-    XX(std::string, key_str, false, false) \
-    XX(std::string, value_str, false, false)
+// Reducer function declarations
+spacetimedb::sdk::ReducerResult kv_put(spacetimedb::sdk::ReducerContext& ctx, const std::string& key, const std::string& value);
+spacetimedb::sdk::ReducerResult kv_get(spacetimedb::sdk::ReducerContext& ctx, const std::string& key);
+spacetimedb::sdk::ReducerResult kv_del(spacetimedb::sdk::ReducerContext& ctx, const std::string& key);
+
+} // namespace spacetimedb_quickstart
 
+#define KEY_VALUE_FIELDS(XX, A, B) \
+    XX(A, B, uint64_t, id, false, false) \
+    XX(A, B, std::string, key_str, false, false) \
+    XX(A, B, std::string, value_str, false, false)
+
+// The registration macros specialize SDK templates, so they are expanded at global scope.
 SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS(
-    spacetimedb_quickstart::KeyValue,
-    "KeyValue",
+    spacetimedb_quickstart::KeyValue, spacetimedb_quickstart_KeyValue, "KeyValue",
     KEY_VALUE_FIELDS,
-    {
+    ({
         SPACETIMEDB_FIELD("id", SpacetimeDb::CoreType::U64, false /* IsUniqueBool */, true /* IsAutoIncBool */),
         SPACETIMEDB_FIELD("key_str", SpacetimeDb::CoreType::String, true /* IsUniqueBool */, false /* IsAutoIncBool */),
         SPACETIMEDB_FIELD("value_str", SpacetimeDb::CoreType::String, false /* IsUniqueBool */, false /* IsAutoIncBool */)
-    }
-);
-
-// Reducer function declarations
-void kv_put(spacetimedb::sdk::ReducerContext& ctx, const std::string& key, const std::string& value);
-void kv_get(spacetimedb::sdk::ReducerContext& ctx, const std::string& key);
-void kv_del(spacetimedb::sdk::ReducerContext& ctx, const std::string& key);
-
-} // namespace spacetimedb_quickstart
+    })
+)
 
 #endif // KV_STORE_H
@@ -2,7 +2,6 @@
 #include <spacetimedb/bsatn/writer.h>
 #include <spacetimedb/bsatn/reader.h>
 #include <variant> // For std::visit
-#include <stdexcept> // For std::runtime_error
 
 // Ensure SpacetimeDb::bsatn::serialize and deserialize are available for all variant types
 // For SDK types, they are already in spacetimedb_sdk_types.h or bsatn/reader.h/writer.h
@@ -105,8 +104,10 @@ namespace sdk_test_cpp {
             this->value = reader.read_vector<sdk_test_cpp::SimpleEnum>();
             break;
         default:
-            // Handle unknown tag, e.g., by throwing an exception
-            throw std::runtime_error("Unknown tag encountered during EnumWithPayload deserialization: " + std::to_string(static_cast<int>(this->tag)));
+            // Unknown tag: reported through the reader, so this also works under SPACETIMEDB_NO_EXCEPTIONS
+            // (the reader throws in ErrorMode::Throw and records the error in ErrorMode::Status).
+            reader.fail(::SpacetimeDb::bsatn::DecodeError::InvalidTag, static_cast<uint64_t>(this->tag));
+            break;
         }
     }
 
@@ -3,22 +3,37 @@
 
 #include "spacetimedb_abi.h" // For the extern "C" ABI function declarations
 #include "common_defs.h"     // For Status, BytesSink, BytesSource
+#include "spacetimedb/internal/exceptions.h" // For SpacetimeDb::Internal::raise
 
 #include <vector>
+#include <memory_resource> // For std::pmr::vector
 #include <string>
 #include <stdexcept> // For std::runtime_error
 #include <cstddef>   // For std::byte (C++17)
+#include <cstdint>
+#include <span>      // For std::span
 
 namespace SpacetimeDB {
 namespace Abi {
 namespace Utils {
 
+// Writes data to a BytesSink and returns the host status (0 on success). Used where a failure
+// must not throw, e.g. when reporting another error.
+inline ::Status try_write_bytes_to_sink(::BytesSink sink_handle, const unsigned char* data, uint32_t len) {
+    return ::_bytes_sink_write(sink_handle, data, len);
+}
+
+inline ::Status try_write_string_to_sink(::BytesSink sink_handle, const std::string& str_data) {
+    return try_write_bytes_to_sink(sink_handle, reinterpret_cast<const unsigned char*>(str_data.data()),
+                                   static_cast<uint32_t>(str_data.length()));
+}
+
 // Helper to write data to a BytesSink.
 // Throws std::runtime_error on host error.
 inline void write_bytes_to_sink(::BytesSink sink_handle, const unsigned char* data, uint32_t len) {
-    ::Status status = ::_bytes_sink_write(sink_handle, data, len);
+    ::Status status = try_write_bytes_to_sink(sink_handle, data, len);
     if (status.inner != 0) { // Assuming 0 is OK from common_defs.h convention
-        throw std::runtime_error("Host failed to write to BytesSink, status: " + std::to_string(status.inner));
+        SpacetimeDb::Internal::raise(std::runtime_error("Host failed to write to BytesSink, status: " + std::to_string(status.inner)));
     }
 }
 
@@ -33,29 +48,51 @@ inline void write_string_to_sink(::BytesSink sink_handle, const std::string& str
 }
 
 
-// Helper to read all remaining data from a BytesSource.
-// Throws std::runtime_error on host error or if read count doesn't match expected.
-inline std::vector<std::byte> read_all_from_source(::BytesSource source_handle) {
-    uint32_t remaining_count = ::_bytes_source_get_remaining_count(source_handle);
-    std::vector<std::byte> buffer(remaining_count);
-
-    if (remaining_count == 0) {
-        return buffer;
+// Reads exactly `count` bytes from a BytesSource into `dest`.
+// Throws std::runtime_error if the source yields fewer.
+inline void read_exact_from_source(::BytesSource source_handle, std::byte* dest, uint32_t count) {
+    if (count == 0) {
+        return;
     }
 
-    uint32_t bytes_read = ::_bytes_source_read(source_handle, reinterpret_cast<uint8_t*>(buffer.data()), remaining_count);
+    uint32_t bytes_read = ::_bytes_source_read(source_handle, reinterpret_cast<uint8_t*>(dest), count);
 
-    if (bytes_read != remaining_count) {
+    if (bytes_read != count) {
         // This could indicate an issue or simply that the source was exhausted unexpectedly.
         // Depending on strictness, one might throw or just resize.
         // For now, assume it should read all that was reported by get_remaining_count.
-        throw std::runtime_error("Failed to read all expected data from BytesSource. Expected: " +
-                                 std::to_string(remaining_count) + ", Got: " + std::to_string(bytes_read));
+        SpacetimeDb::Internal::raise(std::runtime_error("Failed to read all expected data from BytesSource. Expected: " +
+                                                        std::to_string(count) + ", Got: " + std::to_string(bytes_read)));
     }
-    // buffer.resize(bytes_read); // If bytes_read could be less and that's acceptable.
+}
+
+// Helper to read all remaining data from a BytesSource.
+// Throws std::runtime_error on host error or if read count doesn't match expected.
+inline std::vector<std::byte> read_all_from_source(::BytesSource source_handle) {
+    uint32_t remaining_count = ::_bytes_source_get_remaining_count(source_handle);
+    std::vector<std::byte> buffer(remaining_count);
+    read_exact_from_source(source_handle, buffer.data(), remaining_count);
+    return buffer;
+}
+
+// Same, with the buffer allocated from `resource` (e.g. the per-call reducer arena).
+inline std::pmr::vector<std::byte> read_all_from_source(::BytesSource source_handle, std::pmr::memory_resource& resource) {
+    uint32_t remaining_count = ::_bytes_source_get_remaining_count(source_handle);
+    std::pmr::vector<std::byte> buffer(remaining_count, &resource);
+    read_exact_from_source(source_handle, buffer.data(), remaining_count);
     return buffer;
 }
 
+// Reads up to `dest.size()` bytes from a BytesSource into `dest`; returns the count, 0 once the
+// source is exhausted. Used as the pull function of a bsatn::StreamingReader.
+inline size_t read_from_source(::BytesSource source_handle, std::span<std::byte> dest) {
+    if (dest.empty()) {
+        return 0;
+    }
+    uint32_t request = dest.size() > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(dest.size());
+    return ::_bytes_source_read(source_handle, reinterpret_cast<uint8_t*>(dest.data()), request);
+}
+
 // RAII wrappers for BytesSink and BytesSource to ensure _done is called.
 class ManagedBytesSink {
 public:
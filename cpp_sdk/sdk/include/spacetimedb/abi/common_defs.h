@@ -13,11 +13,11 @@ extern "C" {
 // OPAQUE_TYPEDEF(Status, uint16_t);
 typedef struct { uint16_t inner; } Status;
 
-// OPAQUE_TYPEDEF(TableId, uint16_t);
-typedef struct { uint16_t inner; } TableId;
+// OPAQUE_TYPEDEF(TableId, uint32_t);
+typedef struct { uint32_t inner; } TableId;
 
-// OPAQUE_TYPEDEF(IndexId, uint16_t);
-typedef struct { uint16_t inner; } IndexId;
+// OPAQUE_TYPEDEF(IndexId, uint32_t);
+typedef struct { uint32_t inner; } IndexId;
 
 // OPAQUE_TYPEDEF(ColId, uint16_t);
 typedef struct { uint16_t inner; } ColId;
@@ -34,8 +34,8 @@ typedef struct { uint16_t inner; } BytesSink;
 // OPAQUE_TYPEDEF(BytesSource, uint16_t);
 typedef struct { uint16_t inner; } BytesSource;
 
-// OPAQUE_TYPEDEF(RowIter, uint16_t);
-typedef struct { uint16_t inner; } RowIter;
+// OPAQUE_TYPEDEF(RowIter, uint32_t);
+typedef struct { uint32_t inner; } RowIter;
 
 // OPAQUE_TYPEDEF(ConsoleTimerId, uint16_t);
 typedef struct { uint16_t inner; } ConsoleTimerId;
@@ -66,6 +66,28 @@ namespace Abi {
     inline StatusCpp from_abi(Status s) { return static_cast<StatusCpp>(s.inner); }
 
 
+    // Error codes returned by the `spacetime_10.0` host calls.
+    // Mirrors the `errno` constants in crates/primitives/src/errno.rs.
+    enum class Errno : uint16_t {
+        Ok = 0,
+        HostCallFailure = 1,
+        NotInTransaction = 2,
+        BsatnDecodeError = 3,
+        NoSuchTable = 4,
+        NoSuchIndex = 5,
+        NoSuchIter = 6,
+        NoSuchConsoleTimer = 7,
+        NoSuchBytes = 8,
+        NoSpace = 9,
+        BufferTooSmall = 11,
+        UniqueAlreadyExists = 12,
+        ScheduleAtDelayTooLong = 13,
+        IndexNotUnique = 14,
+        NoSuchRow = 15,
+    };
+    inline bool is_errno(::Status s, Errno e) { return s.inner == static_cast<uint16_t>(e); }
+
+
     enum class LogLevelCpp : uint8_t {
         Error = 0,
         Warn = 1,
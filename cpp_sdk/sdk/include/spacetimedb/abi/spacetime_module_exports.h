@@ -35,16 +35,18 @@ SPACETIMEDB_WASM_EXPORT void __describe_module__(BytesSink description_sink_hand
  * @brief Called by the host to execute a specific reducer within the module.
  * @details The module reads arguments from `args_source_handle`, calls the appropriate
  *          C++ reducer function, and writes any error messages to `error_sink_handle`.
+ *          The sender, connection id and timestamp become the reducer's ReducerContext as-is;
+ *          they are not part of the argument bytes.
  *
  * @param reducer_id A numeric identifier for the reducer to be called. The module
  *                   is responsible for mapping this ID to its internal reducer representation.
- * @param sender_identity_p0 Part 0 of the sender's identity (uint64_t).
+ * @param sender_identity_p0 Part 0 of the sender's identity (uint64_t; parts are little-endian words, p0 first).
  * @param sender_identity_p1 Part 1 of the sender's identity (uint64_t).
  * @param sender_identity_p2 Part 2 of the sender's identity (uint64_t).
  * @param sender_identity_p3 Part 3 of the sender's identity (uint64_t).
- * @param connection_id_p0 Part 0 of the connection ID (uint64_t). (If applicable, may be 0)
+ * @param connection_id_p0 Part 0 of the connection ID (uint64_t, low word). (If applicable, may be 0)
  * @param connection_id_p1 Part 1 of the connection ID (uint64_t). (If applicable, may be 0)
- * @param timestamp The host-provided timestamp for the event.
+ * @param timestamp The host-provided timestamp for the event, in microseconds since the Unix epoch.
  * @param args_source_handle An opaque handle from which BSATN-serialized reducer arguments can be read.
  * @param error_sink_handle An opaque handle to which BSATN-serialized error messages (strings) can be written if execution fails.
  * @return A Status code (as int16_t for ABI): 0 for success, non-zero for errors (e.g., reducer not found, deserialization failure before invoker runs).
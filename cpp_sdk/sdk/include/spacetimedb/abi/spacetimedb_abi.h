@@ -147,6 +147,117 @@ uint16_t _iter_start_filtered(
 );
 
 
+// --- Datastore scans and batched row iteration (spacetime_10.0) ---
+// Signatures follow crates/bindings-sys/src/lib.rs. Unlike `_iter_next`, a single
+// `row_iter_bsatn_advance` call copies as many whole rows as fit into a module-owned buffer.
+
+// Returns NOT_IN_TRANSACTION when called outside of a reducer / transaction.
+__attribute__((import_module("spacetime_10.0"), import_name("table_id_from_name")))
+Status table_id_from_name(
+    const uint8_t *name_ptr,
+    uint32_t name_len,
+    TableId *out_table_id_ptr // out-parameter
+);
+
+__attribute__((import_module("spacetime_10.0"), import_name("datastore_table_row_count")))
+Status datastore_table_row_count(
+    TableId table_id,
+    uint64_t *out_count_ptr // out-parameter
+);
+
+__attribute__((import_module("spacetime_10.0"), import_name("datastore_table_scan_bsatn")))
+Status datastore_table_scan_bsatn(
+    TableId table_id,
+    RowIter *out_iter_ptr // out-parameter
+);
+
+__attribute__((import_module("spacetime_10.0"), import_name("index_id_from_name")))
+Status index_id_from_name(
+    const uint8_t *name_ptr,
+    uint32_t name_len,
+    IndexId *out_index_id_ptr // out-parameter
+);
+
+// Scans `index_id` for rows whose first `prefix_elems` columns equal the BSATN `prefix`
+// and whose next column lies within the BSATN-encoded `Bound`s `rstart` and `rend`.
+__attribute__((import_module("spacetime_10.0"), import_name("datastore_index_scan_range_bsatn")))
+Status datastore_index_scan_range_bsatn(
+    IndexId index_id,
+    const uint8_t *prefix_ptr,
+    uint32_t prefix_len,
+    ColId prefix_elems,
+    const uint8_t *rstart_ptr,
+    uint32_t rstart_len,
+    const uint8_t *rend_ptr,
+    uint32_t rend_len,
+    RowIter *out_iter_ptr // out-parameter
+);
+
+// Deprecated host alias of `datastore_index_scan_range_bsatn`, kept for older hosts.
+__attribute__((import_module("spacetime_10.0"), import_name("datastore_btree_scan_bsatn")))
+Status datastore_btree_scan_bsatn(
+    IndexId index_id,
+    const uint8_t *prefix_ptr,
+    uint32_t prefix_len,
+    ColId prefix_elems,
+    const uint8_t *rstart_ptr,
+    uint32_t rstart_len,
+    const uint8_t *rend_ptr,
+    uint32_t rend_len,
+    RowIter *out_iter_ptr // out-parameter
+);
+
+// Deletes every row matched by the same prefix/range arguments as `datastore_index_scan_range_bsatn`.
+__attribute__((import_module("spacetime_10.0"), import_name("datastore_delete_by_index_scan_range_bsatn")))
+Status datastore_delete_by_index_scan_range_bsatn(
+    IndexId index_id,
+    const uint8_t *prefix_ptr,
+    uint32_t prefix_len,
+    ColId prefix_elems,
+    const uint8_t *rstart_ptr,
+    uint32_t rstart_len,
+    const uint8_t *rend_ptr,
+    uint32_t rend_len,
+    uint32_t *out_deleted_count_ptr // out-parameter
+);
+
+// Inserts the BSATN row in `row_ptr[..*row_len_ptr]`. On success the buffer is overwritten with a
+// BSATN `ProductValue` of the values generated for the table's sequence columns, in column order,
+// and `*row_len_ptr` is set to its length (0 if the table has no sequences).
+__attribute__((import_module("spacetime_10.0"), import_name("datastore_insert_bsatn")))
+Status datastore_insert_bsatn(
+    TableId table_id,
+    uint8_t *row_ptr,     // in-out: row in, generated column values out
+    size_t *row_len_ptr   // in-out
+);
+
+// Replaces the row whose projection onto the unique index `index_id` equals that of the given row.
+// Returns NO_SUCH_ROW if there is none. Writes back generated columns like `datastore_insert_bsatn`.
+__attribute__((import_module("spacetime_10.0"), import_name("datastore_update_bsatn")))
+Status datastore_update_bsatn(
+    TableId table_id,
+    IndexId index_id,
+    uint8_t *row_ptr,     // in-out: row in, generated column values out
+    size_t *row_len_ptr   // in-out
+);
+
+// Returns 0 if rows were written and more may follow, -1 if the iterator is exhausted
+// (the host has already destroyed it, so it must not be closed), or a positive errno.
+// On BUFFER_TOO_SMALL, `*buffer_len_ptr` is set to the size needed for the next row.
+// On 0 / -1, `*buffer_len_ptr` is set to the number of bytes written.
+__attribute__((import_module("spacetime_10.0"), import_name("row_iter_bsatn_advance")))
+int16_t row_iter_bsatn_advance(
+    RowIter iter,
+    uint8_t *buffer_ptr,    // out-parameter for concatenated BSATN rows
+    size_t *buffer_len_ptr  // in-out: buffer capacity in, bytes written out
+);
+
+__attribute__((import_module("spacetime_10.0"), import_name("row_iter_bsatn_close")))
+uint16_t row_iter_bsatn_close(
+    RowIter iter // Taken by value, implies consumption
+);
+
+
 // --- BytesSink and BytesSource Operations ---
 // Based on common/bindings.c style, assuming "spacetime" module
 // These might need different import_name if already defined by host with other names.
@@ -9,11 +9,20 @@
  *          - bsatn::Writer
  *          - Placeholder types for 128-bit integers.
  *          - Generic bsatn::serialize and bsatn::deserialize<T> free function templates and their overloads/specializations.
+ *          - bsatn::encoded_size, the exact encoded size of a value (constexpr for fixed-size types).
+ *          - bsatn::skip and bsatn::deserialize_projected, for decoding only some fields of a struct.
+ *          - bsatn::StreamingReader, a Reader that pulls its input in chunks.
+ *          - bsatn::SinkWriter, a Writer that pushes its output in chunks.
  */
 
 #include "reader.h"      // Defines bsatn::Reader
 #include "writer.h"      // Defines bsatn::Writer and primitive bsatn::serialize overloads
 #include "uint128_placeholder.h" // Defines SpacetimeDB::Types::uint128_t_placeholder etc.
+#include "size.h"        // Defines bsatn::encoded_size
+#include "traits.h"      // Defines bsatn::is_bulk_copyable_v
+#include "projection.h"  // Defines bsatn::skip, bsatn::FieldMask and bsatn::deserialize_projected
+#include "streaming_reader.h" // Defines bsatn::StreamingReader
+#include "sink_writer.h"      // Defines bsatn::SinkWriter
 
 // The bsatn namespace contains the core Reader and Writer classes,
 // along with global `serialize` overloads for primitives and `deserialize<T>` specializations for primitives.
@@ -33,4 +42,25 @@
 // This allows user code and SDK internals to uniformly use `bsatn::serialize(writer, obj)`
 // and `obj = bsatn::deserialize<MyType>(reader)`.
 
+#include <concepts>    // For std::same_as
+#include <type_traits> // For std::is_pointer_v
+
+namespace SpacetimeDb::bsatn {
+
+    // A type `bsatn::serialize(writer, value)` accepts. Unqualified, so the overloads that
+    // SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS declares after this header are found through the Writer.
+    // Pointers are excluded, as they would convert to `bool`.
+    template<typename T>
+    concept Serializable = !std::is_pointer_v<T> && requires(Writer& w, const T& value) { serialize(w, value); };
+
+    // A type `bsatn::deserialize<T>(reader)` decodes.
+    template<typename T>
+    concept Deserializable = requires(Reader& r) { { ::SpacetimeDb::bsatn::deserialize<T>(r) } -> std::same_as<T>; };
+
+    // A type that round-trips through BSATN, as table rows must.
+    template<typename T>
+    concept Codec = Serializable<T> && Deserializable<T>;
+
+} // namespace SpacetimeDb::bsatn
+
 #endif // SPACETIMEDB_BSATN_MAIN_H
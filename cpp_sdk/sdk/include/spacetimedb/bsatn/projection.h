@@ -0,0 +1,123 @@
+#ifndef SPACETIMEDB_BSATN_PROJECTION_H
+#define SPACETIMEDB_BSATN_PROJECTION_H
+
+#include "reader.h"
+#include "size.h" // For size_traits (fixed-size values are skipped in one step)
+#include "spacetimedb/internal/exceptions.h" // For SpacetimeDb::Internal::raise
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace SpacetimeDb::bsatn {
+
+    /**
+     * @brief Advances `r` past one encoded `T` without building it.
+     * @details Fixed-size values (primitives, enums, structs of fixed-width fields) are skipped
+     *          with a single bounds check; strings and byte arrays by their length prefix, so
+     *          nothing is allocated. Lengths and sum tags are validated, values are not (e.g. a
+     *          bool byte of 2 is skipped). SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS specializes this
+     *          for each struct; other types without a specialization are decoded and discarded.
+     */
+    template<typename T>
+    void skip(Reader& r) {
+        if constexpr (is_fixed_size_v<T>) {
+            r.skip_bytes(size_traits<T>::fixed_size);
+        }
+        else if constexpr (is_std_optional_v<T>) {
+            uint8_t tag = r.read_u8();
+            if (tag == 1) {
+                skip<typename T::value_type>(r);
+            } else if (tag != 0) {
+                r.fail(DecodeError::InvalidTag, tag);
+            }
+        }
+        else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+            (void)r.read_string_view();
+        }
+        else if constexpr (std::is_same_v<T, std::span<const std::byte>>) {
+            (void)r.read_bytes_span();
+        }
+        else if constexpr (is_std_vector_v<T>) {
+            using Elem = typename T::value_type;
+            uint32_t count = r.read_vector_count();
+            if constexpr (is_fixed_size_v<Elem>) {
+                r.skip_bytes(static_cast<size_t>(count) * size_traits<Elem>::fixed_size);
+            } else {
+                for (uint32_t i = 0; i < count && r.ok(); ++i) {
+                    skip<Elem>(r);
+                }
+            }
+        }
+        else {
+            (void)deserialize<T>(r);
+        }
+    }
+
+    /**
+     * @brief Set of fields of a struct to decode, by position in its SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS list.
+     * @details Only the first 64 fields can be left out; fields past that are always decoded.
+     */
+    struct FieldMask {
+        uint64_t bits = ~uint64_t{0};
+
+        static constexpr FieldMask all() { return FieldMask{}; }
+        constexpr bool is_all() const { return bits == ~uint64_t{0}; }
+        constexpr bool selects(size_t field_index) const {
+            return field_index >= 64 || ((bits >> field_index) & 1) != 0;
+        }
+    };
+
+    inline constexpr size_t no_field_index = static_cast<size_t>(-1);
+
+    /**
+     * @brief Position of the field named `name` in `T`, or `no_field_index`.
+     * @details Specialized by SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS.
+     */
+    template<typename T>
+    size_t field_index(std::string_view name) {
+        (void)name;
+        return no_field_index;
+    }
+
+    /**
+     * @brief Mask selecting the named fields of `T`, e.g. `field_mask<Player>({"id", "x"})`.
+     * @throws std::runtime_error if `T` has no field with one of the names (a fatal error under SPACETIMEDB_NO_EXCEPTIONS).
+     */
+    template<typename T>
+    FieldMask field_mask(std::initializer_list<std::string_view> names) {
+        FieldMask mask{0};
+        for (std::string_view name : names) {
+            size_t index = field_index<T>(name);
+            if (index == no_field_index) {
+                Internal::raise(std::runtime_error("bsatn::field_mask: type has no field '" + std::string(name) + "'"));
+            }
+            if (index < 64) {
+                mask.bits |= uint64_t{1} << index;
+            }
+        }
+        return mask;
+    }
+
+    /**
+     * @brief Decodes a `T` in which only the fields in `mask` are materialized.
+     * @details The other fields are skipped (see `skip<T>`) and left value-initialized. The
+     *          whole encoded value is consumed either way. SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS
+     *          specializes this; for other types every field is decoded.
+     */
+    template<typename T>
+    T deserialize_projected(Reader& r, FieldMask mask) {
+        (void)mask;
+        return deserialize<T>(r);
+    }
+
+} // namespace SpacetimeDb::bsatn
+
+#endif // SPACETIMEDB_BSATN_PROJECTION_H
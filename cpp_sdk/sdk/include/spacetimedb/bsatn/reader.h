@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 #include <cstdint>
 #include <stdexcept> // For std::runtime_error
 #include <optional>  // Ensure std::optional is available
@@ -10,6 +11,7 @@
 #include <span> // For std::span (C++20)
 #include <type_traits> // For std::is_enum, std::is_same_v, std::true_type, std::false_type
 #include <cstring> // For memcpy
+#include "traits.h" // For is_bulk_copyable_v
 #include "uint128_placeholder.h" // Assumes this is in the same directory or accessible via include paths
 #include "spacetimedb/sdk/spacetimedb_sdk_types.h" // For u256_placeholder, i256_placeholder
 
@@ -30,32 +32,193 @@ namespace SpacetimeDb::bsatn {
     template<typename T> struct is_std_optional<std::optional<T>> : std::true_type {};
     template<typename T> constexpr bool is_std_optional_v = is_std_optional<T>::value;
 
+    // Fixed-width values `Reader::read_unchecked<T>()` can read; each is `sizeof(T)` bytes in BSATN.
+    template<typename T>
+    inline constexpr bool is_fixed_primitive_v =
+        (is_bulk_copyable_v<T> && !std::is_same_v<T, std::byte>) ||
+        std::is_same_v<T, bool> ||
+        std::is_same_v<T, SpacetimeDb::Types::uint128_t_placeholder> ||
+        std::is_same_v<T, SpacetimeDb::Types::int128_t_placeholder>;
+
+    /**
+     * @brief Why decoding failed.
+     */
+    enum class DecodeError : uint8_t {
+        None = 0,
+        UnexpectedEnd, // Fewer bytes left than the value needs.
+        InvalidBool,   // A bool byte other than 0 or 1.
+        InvalidTag,    // A sum type (e.g. optional) tag with no matching variant.
+        LengthLimit    // A string / vector length above the Reader's sanity limit.
+    };
+
+    inline const char* decode_error_message(DecodeError error) {
+        switch (error) {
+            case DecodeError::None: return "no error";
+            case DecodeError::UnexpectedEnd: return "unexpected end of input";
+            case DecodeError::InvalidBool: return "invalid bool value";
+            case DecodeError::InvalidTag: return "invalid sum type tag";
+            case DecodeError::LengthLimit: return "length exceeds sanity limit";
+        }
+        return "unknown error";
+    }
+
+    /**
+     * @brief How a Reader reports a decoding failure.
+     * @details `Throw` (the default) throws from the failing read. `Status` records the first
+     *          error instead, makes the failing read return a default value and lets the caller
+     *          check `Reader::ok()` once at the end; the SDK decodes rows and reducer arguments
+     *          this way (see `try_deserialize`). Under SPACETIMEDB_NO_EXCEPTIONS, a failure in
+     *          `Throw` mode is fatal, so decode untrusted input in `Status` mode.
+     */
+    enum class ErrorMode : uint8_t {
+        Throw,
+        Status
+    };
+
     class Reader {
     public:
         // Constructors
-        Reader(const std::byte* data, size_t size) : current_ptr(data), end_ptr(data + size) {}
-        Reader(std::span<const std::byte> data) : current_ptr(data.data()), end_ptr(data.data() + data.size()) {}
-
-        bool read_bool();
-        uint8_t read_u8();
-        uint16_t read_u16_le();
-        uint32_t read_u32_le();
-        uint64_t read_u64_le();
-        SpacetimeDb::Types::uint128_t_placeholder read_u128_le(); // Corrected namespace
+        Reader(const std::byte* data, size_t size, ErrorMode mode = ErrorMode::Throw)
+            : current_ptr(data), end_ptr(data + size), error_mode_(mode) {}
+        Reader(std::span<const std::byte> data, ErrorMode mode = ErrorMode::Throw)
+            : current_ptr(data.data()), end_ptr(data.data() + data.size()), error_mode_(mode) {}
+
+        // The first error recorded in ErrorMode::Status; DecodeError::None otherwise.
+        DecodeError error() const { return error_; }
+        bool ok() const { return error_ == DecodeError::None; }
+
+        ErrorMode error_mode() const { return error_mode_; }
+        // Returns the previous mode.
+        ErrorMode set_error_mode(ErrorMode mode) {
+            ErrorMode previous = error_mode_;
+            error_mode_ = mode;
+            return previous;
+        }
+
+        /**
+         * @brief Reports a decoding failure according to the error mode.
+         * @details Throws in ErrorMode::Throw (std::out_of_range for UnexpectedEnd,
+         *          std::runtime_error otherwise; `value` is the requested size, bad byte or
+         *          length, for the message), or aborts under SPACETIMEDB_NO_EXCEPTIONS. In
+         *          ErrorMode::Status, records the first error and returns. Out of line: this
+         *          is the cold path of every read.
+         */
+        void fail(DecodeError error, uint64_t value = 0);
+
+        /**
+         * @brief Checks that `count` more bytes are available.
+         * @details Inline so the common case is a single compare. On a shortfall, a streaming
+         *          Reader first pulls more input (see StreamingReader); if there is still not
+         *          enough, reports DecodeError::UnexpectedEnd and returns false (in
+         *          ErrorMode::Status); the caller must not read the bytes then.
+         */
+        bool ensure_bytes(size_t count) {
+            if (static_cast<size_t>(end_ptr - current_ptr) < count) [[unlikely]] {
+                return refill_or_fail(count);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Reads one fixed-width primitive without a bounds check.
+         * @details Internal fast path: the caller must already have called `ensure_bytes()` for
+         *          at least `sizeof(T)` bytes (16 for the 128-bit placeholders). Checking a whole
+         *          fixed-size struct once and then reading every field with this lets the
+         *          compiler turn the loads into straight-line code. `bool` is still validated.
+         */
+        template<typename T>
+        T read_unchecked() {
+            if constexpr (std::is_same_v<T, bool>) {
+                uint8_t val = static_cast<uint8_t>(*current_ptr++);
+                if (val > 1) [[unlikely]] { // Strict bool (0 or 1)
+                    fail(DecodeError::InvalidBool, val);
+                    return false;
+                }
+                return val == 1;
+            }
+            else if constexpr (std::is_same_v<T, SpacetimeDb::Types::uint128_t_placeholder>) {
+                SpacetimeDb::Types::uint128_t_placeholder val;
+                val.low = read_unchecked<uint64_t>();  // Little-endian: lower part first
+                val.high = read_unchecked<uint64_t>();
+                return val;
+            }
+            else if constexpr (std::is_same_v<T, SpacetimeDb::Types::int128_t_placeholder>) {
+                SpacetimeDb::Types::int128_t_placeholder val;
+                val.low = read_unchecked<uint64_t>();
+                val.high = read_unchecked<int64_t>(); // Signed high part
+                return val;
+            }
+            else if constexpr (std::is_class_v<T> && is_bulk_copyable_v<T>) {
+                T val; // Wide integers and bitwise-layout structs: layout == wire layout, one copy.
+                std::memcpy(&val, current_ptr, sizeof(T));
+                current_ptr += sizeof(T);
+                return val;
+            }
+            else {
+                static_assert(std::is_arithmetic_v<T>, "Reader::read_unchecked supports fixed-width primitives only.");
+                // BSATN is little-endian; on a little-endian target this is a plain load.
+                T val;
+                std::memcpy(&val, current_ptr, sizeof(T));
+                current_ptr += sizeof(T);
+                return val;
+            }
+        }
+
+        bool read_bool() { return ensure_bytes(1) ? read_unchecked<bool>() : bool{}; }
+        uint8_t read_u8() { return ensure_bytes(sizeof(uint8_t)) ? read_unchecked<uint8_t>() : uint8_t{}; }
+        uint16_t read_u16_le() { return ensure_bytes(sizeof(uint16_t)) ? read_unchecked<uint16_t>() : uint16_t{}; }
+        uint32_t read_u32_le() { return ensure_bytes(sizeof(uint32_t)) ? read_unchecked<uint32_t>() : uint32_t{}; }
+        uint64_t read_u64_le() { return ensure_bytes(sizeof(uint64_t)) ? read_unchecked<uint64_t>() : uint64_t{}; }
+        SpacetimeDb::Types::uint128_t_placeholder read_u128_le() {
+            if (!ensure_bytes(16)) return {};
+            return read_unchecked<SpacetimeDb::Types::uint128_t_placeholder>();
+        }
         SpacetimeDb::sdk::u256_placeholder read_u256_le(); // Declaration
 
-        int8_t read_i8();
-        int16_t read_i16_le();
-        int32_t read_i32_le();
-        int64_t read_i64_le();
-        SpacetimeDb::Types::int128_t_placeholder read_i128_le(); // Corrected namespace
+        int8_t read_i8() { return ensure_bytes(sizeof(int8_t)) ? read_unchecked<int8_t>() : int8_t{}; }
+        int16_t read_i16_le() { return ensure_bytes(sizeof(int16_t)) ? read_unchecked<int16_t>() : int16_t{}; }
+        int32_t read_i32_le() { return ensure_bytes(sizeof(int32_t)) ? read_unchecked<int32_t>() : int32_t{}; }
+        int64_t read_i64_le() { return ensure_bytes(sizeof(int64_t)) ? read_unchecked<int64_t>() : int64_t{}; }
+        SpacetimeDb::Types::int128_t_placeholder read_i128_le() {
+            if (!ensure_bytes(16)) return {};
+            return read_unchecked<SpacetimeDb::Types::int128_t_placeholder>();
+        }
         SpacetimeDb::sdk::i256_placeholder read_i256_le(); // Declaration
 
-        float read_f32_le();
-        double read_f64_le();
+        float read_f32_le() { return ensure_bytes(sizeof(float)) ? read_unchecked<float>() : float{}; }
+        double read_f64_le() { return ensure_bytes(sizeof(double)) ? read_unchecked<double>() : double{}; }
 
         std::string read_string();
         std::vector<std::byte> read_bytes(); // Reads a length-prefixed byte array
+
+        /**
+         * @brief Zero-copy counterparts of `read_string()` / `read_bytes()`.
+         * @details The returned view points into the buffer this Reader was constructed over and
+         *          is only valid while that buffer is alive and unmodified. For rows decoded by a
+         *          `RowIterator`, that is until the next call to `next()`.
+         */
+        std::string_view read_string_view() {
+            uint32_t len = read_u32_le();
+            if (len > max_string_length_sanity_check) [[unlikely]] {
+                fail(DecodeError::LengthLimit, len);
+                return {};
+            }
+            if (!ensure_bytes(len)) return {};
+            std::string_view str(reinterpret_cast<const char*>(current_ptr), len);
+            current_ptr += len;
+            return str;
+        }
+        std::span<const std::byte> read_bytes_span() {
+            uint32_t len = read_u32_le();
+            if (len > max_vector_elements_sanity_check) [[unlikely]] {
+                fail(DecodeError::LengthLimit, len);
+                return {};
+            }
+            if (!ensure_bytes(len)) return {};
+            std::span<const std::byte> bytes(current_ptr, len);
+            current_ptr += len;
+            return bytes;
+        }
         std::vector<std::byte> read_fixed_bytes(size_t count); // Reads a fixed number of bytes
 
         template<typename T>
@@ -71,32 +234,106 @@ namespace SpacetimeDb::bsatn {
             else if (tag == 1) {
                 return deserialize<T>(*this);
             }
-            throw std::runtime_error("Invalid tag for optional type in Reader::read_optional(): " + std::to_string(tag));
+            fail(DecodeError::InvalidTag, tag);
+            return std::nullopt;
         }
 
         template<typename T>
         std::vector<T> read_vector() {
-            uint32_t count = read_u32_le();
+            uint32_t count = read_vector_count();
             std::vector<T> vec;
-            if (count > max_vector_elements_sanity_check) {
-                throw std::runtime_error("Vector element count " + std::to_string(count) + " exceeds sanity limit " + std::to_string(max_vector_elements_sanity_check));
+            if (!ok()) [[unlikely]] {
+                return vec;
+            }
+            if constexpr (is_bulk_copyable_v<T>) {
+                const size_t byte_count = static_cast<size_t>(count) * sizeof(T);
+                if (!refill_hook_ && !ensure_bytes(byte_count)) return vec; // Reject bad counts before allocating.
+                vec.resize(count);
+                // Wire layout == memory layout. A streaming Reader copies chunk by chunk.
+                if (!read_raw_into(reinterpret_cast<std::byte*>(vec.data()), byte_count)) return {};
+                return vec;
             }
             vec.reserve(count);
             for (uint32_t i = 0; i < count; ++i) {
                 vec.push_back(deserialize<T>(*this)); // This deserialize call is the key
+                if (error_ != DecodeError::None) [[unlikely]] {
+                    return {}; // Status mode: stop at the first bad element.
+                }
             }
             return vec;
         }
 
         std::vector<std::byte> read_vector_byte();
 
-        bool is_eos() const;
-        size_t remaining_bytes() const;
-        void ensure_bytes(size_t count);
+        // Reads a vector's element count and checks it against the sanity limit (0 on failure).
+        uint32_t read_vector_count() {
+            uint32_t count = read_u32_le();
+            if (count > max_vector_elements_sanity_check) [[unlikely]] {
+                fail(DecodeError::LengthLimit, count);
+                return 0;
+            }
+            return count;
+        }
+
+        // Advances past `count` bytes without reading them.
+        void skip_bytes(size_t count) {
+            if (static_cast<size_t>(end_ptr - current_ptr) >= count) [[likely]] {
+                current_ptr += count;
+                return;
+            }
+            skip_bytes_slow(count);
+        }
+
+        /**
+         * @brief Copies the next `count` bytes into `dest`.
+         * @details Bounds-checked like the other reads. A streaming Reader copies whatever is
+         *          buffered and refills as needed, so `count` may exceed its buffer.
+         */
+        bool read_raw_into(std::byte* dest, size_t count) {
+            if (static_cast<size_t>(end_ptr - current_ptr) >= count) [[likely]] {
+                if (count != 0) {
+                    std::memcpy(dest, current_ptr, count);
+                    current_ptr += count;
+                }
+                return true;
+            }
+            return read_raw_into_slow(dest, count);
+        }
+
+        // For a streaming Reader these only cover the buffered bytes; see StreamingReader::is_eos().
+        bool is_eos() const { return current_ptr >= end_ptr; }
+        size_t remaining_bytes() const {
+            return current_ptr >= end_ptr ? 0 : static_cast<size_t>(end_ptr - current_ptr);
+        }
+
+    protected:
+        /**
+         * @brief Called when fewer than `count` bytes are buffered.
+         * @details Must make at least `count` bytes available through `set_window()` (keeping
+         *          the unread ones) and return true, or return false at the end of the input.
+         */
+        using RefillHook = bool (*)(Reader& reader, size_t count);
+
+        Reader(RefillHook hook, ErrorMode mode)
+            : error_mode_(mode), refill_hook_(hook) {}
+
+        const std::byte* window_begin() const { return current_ptr; }
+        void set_window(const std::byte* begin, const std::byte* end) {
+            current_ptr = begin;
+            end_ptr = end;
+        }
 
     private:
+        // Cold paths, out of line in reader.cpp.
+        bool refill_or_fail(size_t count);
+        void skip_bytes_slow(size_t count);
+        bool read_raw_into_slow(std::byte* dest, size_t count);
+
         const std::byte* current_ptr = nullptr;
         const std::byte* end_ptr = nullptr;
+        ErrorMode error_mode_ = ErrorMode::Throw;
+        DecodeError error_ = DecodeError::None;
+        RefillHook refill_hook_ = nullptr;
 
         static const uint32_t max_string_length_sanity_check = 1024 * 1024 * 10;
         static const uint32_t max_vector_elements_sanity_check = 1024 * 1024;
@@ -105,7 +342,7 @@ namespace SpacetimeDb::bsatn {
     // Moved inline definitions for 256-bit types
     inline SpacetimeDb::sdk::u256_placeholder Reader::read_u256_le() {
         SpacetimeDb::sdk::u256_placeholder val;
-        ensure_bytes(sizeof(val.data)); // Assuming data is std::array<uint64_t, 4>
+        if (!ensure_bytes(sizeof(val.data))) return val; // Assuming data is std::array<uint64_t, 4>
         memcpy(val.data.data(), current_ptr, sizeof(val.data));
         current_ptr += sizeof(val.data);
         // TODO: Handle endianness if necessary for each uint64_t component
@@ -114,7 +351,7 @@ namespace SpacetimeDb::bsatn {
 
     inline SpacetimeDb::sdk::i256_placeholder Reader::read_i256_le() {
         SpacetimeDb::sdk::i256_placeholder val;
-        ensure_bytes(sizeof(val.data));
+        if (!ensure_bytes(sizeof(val.data))) return val;
         memcpy(val.data.data(), current_ptr, sizeof(val.data));
         current_ptr += sizeof(val.data);
         // TODO: Handle endianness
@@ -141,7 +378,22 @@ namespace SpacetimeDb::bsatn {
             else if (tag == 1) {
                 return T(deserialize<InnerType>(r)); // Construct std::optional<InnerType> from deserialized InnerType
             }
-            throw std::runtime_error("Invalid tag for optional type in deserialize: " + std::to_string(tag));
+            r.fail(DecodeError::InvalidTag, tag);
+            return T(std::nullopt);
+        }
+        else if constexpr (is_fixed_primitive_v<T>) {
+            return r.ensure_bytes(sizeof(T)) ? r.read_unchecked<T>() : T{};
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            return r.read_string();
+        }
+        else if constexpr (is_std_vector_v<T>) {
+            return r.read_vector<typename T::value_type>();
+        }
+        else if constexpr (requires(T& value) { value.bsatn_deserialize(r); }) {
+            T value{};
+            value.bsatn_deserialize(r);
+            return value;
         }
         // Removed the direct `else` to allow other `else if` conditions or a final `else` for other types.
         // Fallback for other types (non-enum, non-optional) that require specialized handling.
@@ -151,6 +403,85 @@ namespace SpacetimeDb::bsatn {
         }
     }
 
+    /**
+     * @brief Reads one field of a fixed-size struct after the struct's single bounds check.
+     * @details Used by the `deserialize<T>` that SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS generates
+     *          once `ensure_bytes(size_traits<T>::fixed_size)` has succeeded. Primitives use
+     *          `Reader::read_unchecked`; anything else (e.g. a nested struct) takes its usual,
+     *          checked path.
+     */
+    template<typename T>
+    void read_fixed_field(Reader& r, T& field) {
+        if constexpr (is_fixed_primitive_v<T>) {
+            field = r.read_unchecked<T>();
+        }
+        else if constexpr (requires { field.bsatn_deserialize(r); }) {
+            field.bsatn_deserialize(r);
+        }
+        else {
+            field = deserialize<T>(r);
+        }
+    }
+
+    // Borrowed views; see Reader::read_string_view(). Used by row types with view fields.
+    template<>
+    inline std::string_view deserialize<std::string_view>(Reader& r) {
+        return r.read_string_view();
+    }
+
+    template<>
+    inline std::span<const std::byte> deserialize<std::span<const std::byte>>(Reader& r) {
+        return r.read_bytes_span();
+    }
+
+    /**
+     * @brief Result of a non-throwing decode: the value, or why it could not be decoded.
+     */
+    template<typename T>
+    struct DecodeResult {
+        T value{};
+        DecodeError error = DecodeError::None;
+
+        bool ok() const { return error == DecodeError::None; }
+        explicit operator bool() const { return ok(); }
+    };
+
+    /**
+     * @brief Decodes a `T` from `r` without throwing on malformed input.
+     * @details Runs `deserialize<T>` with `r` in ErrorMode::Status and restores its mode
+     *          afterwards. On failure, `value` holds whatever was decoded before the error and
+     *          must not be used. `deserialize<T>` in the default ErrorMode::Throw is the
+     *          throwing counterpart.
+     */
+    template<typename T>
+    DecodeResult<T> try_deserialize(Reader& r) {
+        ErrorMode previous = r.set_error_mode(ErrorMode::Status);
+        DecodeResult<T> result{deserialize<T>(r), DecodeError::None};
+        r.set_error_mode(previous);
+        result.error = r.error();
+        return result;
+    }
+
+    template<typename T>
+    DecodeResult<T> try_deserialize(std::span<const std::byte> data) {
+        Reader reader(data, ErrorMode::Status);
+        DecodeResult<T> result{deserialize<T>(reader), DecodeError::None};
+        result.error = reader.error();
+        return result;
+    }
+
+    /**
+     * @brief Reads host-generated column values (e.g. auto-increment) into `obj`.
+     * @details The input is the `ProductValue` the host writes back after an insert or update: the
+     *          values of `T`'s sequence columns, in field order. SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS
+     *          specializes this for each row type; the primary template reads nothing.
+     */
+    template<typename T>
+    void apply_generated_columns(Reader& r, T& obj) {
+        (void)r;
+        (void)obj;
+    }
+
     // Definition for deserialize_specialized (if needed, or could be specialized elsewhere)
     // For now, this remains a declaration as in the original file.
     // template<typename T> T deserialize_specialized(Reader& r) {
@@ -0,0 +1,58 @@
+#ifndef SPACETIMEDB_BSATN_SINK_WRITER_H
+#define SPACETIMEDB_BSATN_SINK_WRITER_H
+
+#include "writer.h"
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace SpacetimeDb::bsatn {
+
+    /**
+     * @brief A Writer that hands its output to a callback in chunks instead of keeping it.
+     * @details Writes go into a small buffer through the usual inline Writer paths; when it is
+     *          full, its contents are passed to `push` and it is reused. A single write larger
+     *          than the buffer is passed through directly. Peak memory is the buffer, whatever
+     *          the size of the output.
+     *
+     *          Call `flush()` after the last write: it pushes the remaining bytes and reports
+     *          errors from `push`. The destructor flushes too, but swallows such errors.
+     *          `view()` / `size()` only cover the bytes not pushed yet.
+     */
+    class SinkWriter : public Writer {
+    public:
+        // Consumes one chunk of output; may throw. Under SPACETIMEDB_NO_EXCEPTIONS it must record
+        // its own failures (and may ignore the chunks after one).
+        using PushFn = std::function<void(std::span<const std::byte> bytes)>;
+
+        static constexpr size_t default_buffer_size = 4 * 1024;
+
+        explicit SinkWriter(PushFn push, size_t buffer_size = default_buffer_size);
+        ~SinkWriter();
+
+        SinkWriter(const SinkWriter&) = delete;
+        SinkWriter& operator=(const SinkWriter&) = delete;
+
+        // Pushes the buffered bytes.
+        void flush();
+
+        // Bytes written so far, pushed or not.
+        size_t total_size() const { return pushed_ + size(); }
+
+    private:
+        // The buffer is allocated before the Writer base is pointed at it; moving it into
+        // `storage_` keeps its address.
+        SinkWriter(PushFn push, std::vector<std::byte>&& storage);
+
+        static void flush_hook(Writer& writer, std::span<const std::byte> bytes);
+
+        std::vector<std::byte> storage_;
+        PushFn push_;
+        size_t pushed_ = 0;
+    };
+
+} // namespace SpacetimeDb::bsatn
+
+#endif // SPACETIMEDB_BSATN_SINK_WRITER_H
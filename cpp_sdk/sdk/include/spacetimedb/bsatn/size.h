@@ -0,0 +1,164 @@
+#ifndef SPACETIMEDB_BSATN_SIZE_H
+#define SPACETIMEDB_BSATN_SIZE_H
+
+#include "reader.h" // For is_std_optional_v
+#include "writer.h" // For Writer (reserve_encoded)
+#include "uint128_placeholder.h"
+#include "spacetimedb/sdk/spacetimedb_sdk_types.h" // For u256_placeholder, i256_placeholder
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace SpacetimeDb::bsatn {
+
+    /**
+     * @brief Encoded-size information for `T`.
+     * @details Specialized for primitives here and for every struct registered with
+     *          SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS by the macro. A specialization has:
+     *          - `is_fixed`: every value of `T` encodes to the same number of bytes;
+     *          - `fixed_size`: that number (0 if not fixed);
+     *          - `encoded_size(const T&)`: the exact size of one value (structs only).
+     *          The primary template marks a type as variable-size; `encoded_size(const T&)`
+     *          only accepts such types if it knows their shape (strings, vectors, optionals).
+     */
+    template<typename T, typename Enable = void>
+    struct size_traits {
+        static constexpr bool is_fixed = false;
+        static constexpr size_t fixed_size = 0;
+    };
+
+    template<typename T>
+    struct fixed_size_traits {
+        static constexpr bool is_fixed = true;
+        static constexpr size_t fixed_size = sizeof(T);
+    };
+
+    template<> struct size_traits<bool> : fixed_size_traits<uint8_t> {};
+    template<> struct size_traits<uint8_t> : fixed_size_traits<uint8_t> {};
+    template<> struct size_traits<uint16_t> : fixed_size_traits<uint16_t> {};
+    template<> struct size_traits<uint32_t> : fixed_size_traits<uint32_t> {};
+    template<> struct size_traits<uint64_t> : fixed_size_traits<uint64_t> {};
+    template<> struct size_traits<int8_t> : fixed_size_traits<int8_t> {};
+    template<> struct size_traits<int16_t> : fixed_size_traits<int16_t> {};
+    template<> struct size_traits<int32_t> : fixed_size_traits<int32_t> {};
+    template<> struct size_traits<int64_t> : fixed_size_traits<int64_t> {};
+    template<> struct size_traits<float> : fixed_size_traits<uint32_t> {};
+    template<> struct size_traits<double> : fixed_size_traits<uint64_t> {};
+    template<> struct size_traits<SpacetimeDb::Types::uint128_t_placeholder> {
+        static constexpr bool is_fixed = true;
+        static constexpr size_t fixed_size = 16;
+    };
+    template<> struct size_traits<SpacetimeDb::Types::int128_t_placeholder> {
+        static constexpr bool is_fixed = true;
+        static constexpr size_t fixed_size = 16;
+    };
+    template<> struct size_traits<SpacetimeDb::sdk::u256_placeholder> {
+        static constexpr bool is_fixed = true;
+        static constexpr size_t fixed_size = 32;
+    };
+    template<> struct size_traits<SpacetimeDb::sdk::i256_placeholder> {
+        static constexpr bool is_fixed = true;
+        static constexpr size_t fixed_size = 32;
+    };
+
+    // SDK types encoded as a fixed number of bytes by their `bsatn_serialize`.
+    template<> struct size_traits<SpacetimeDb::sdk::Identity> {
+        static constexpr bool is_fixed = true;
+        static constexpr size_t fixed_size = SpacetimeDb::sdk::IDENTITY_SIZE;
+    };
+    template<> struct size_traits<SpacetimeDb::sdk::Timestamp> : fixed_size_traits<uint64_t> {};
+    template<> struct size_traits<SpacetimeDb::sdk::ScheduleAt> : fixed_size_traits<uint64_t> {};
+    template<> struct size_traits<SpacetimeDb::sdk::ConnectionId> : fixed_size_traits<uint64_t> {};
+    template<> struct size_traits<SpacetimeDb::sdk::TimeDuration> : fixed_size_traits<int64_t> {};
+
+    template<typename T>
+    struct size_traits<T, std::enable_if_t<SpacetimeDb::Types::is_wide_integer_v<T>>> : fixed_size_traits<T> {};
+
+    // Enums are written as a single u8 tag (see the generic serialize / deserialize).
+    template<typename T>
+    struct size_traits<T, std::enable_if_t<std::is_enum_v<T>>> : fixed_size_traits<uint8_t> {};
+
+    template<typename T>
+    inline constexpr bool is_fixed_size_v = size_traits<std::remove_cv_t<T>>::is_fixed;
+
+    template<typename T, typename = void>
+    struct has_size_traits_encoded_size : std::false_type {};
+    template<typename T>
+    struct has_size_traits_encoded_size<T, std::void_t<decltype(size_traits<T>::encoded_size(std::declval<const T&>()))>>
+        : std::true_type {};
+
+    /**
+     * @brief Encoded size of every value of `T`, as a compile-time constant.
+     * @details Only available for fixed-size types (`is_fixed_size_v<T>`), e.g. a struct whose
+     *          fields are all primitives.
+     */
+    template<typename T>
+    constexpr size_t encoded_size() {
+        static_assert(is_fixed_size_v<T>, "bsatn::encoded_size<T>() requires a fixed-size type; use encoded_size(value).");
+        return size_traits<std::remove_cv_t<T>>::fixed_size;
+    }
+
+    /**
+     * @brief Exact number of bytes `serialize(writer, value)` appends.
+     * @details Constant for fixed-size types; otherwise a pass over the value's strings,
+     *          vectors and optionals that allocates nothing. A type with neither a
+     *          `size_traits` specialization nor one of those shapes does not compile here,
+     *          rather than being measured by serializing it.
+     */
+    template<typename T>
+    size_t encoded_size(const T& value) {
+        if constexpr (is_fixed_size_v<T>) {
+            return size_traits<T>::fixed_size;
+        }
+        else if constexpr (is_std_optional_v<T>) {
+            return 1 + (value.has_value() ? encoded_size(*value) : 0);
+        }
+        else if constexpr (is_std_vector_v<T>) {
+            using Elem = typename T::value_type;
+            if constexpr (is_fixed_size_v<Elem>) {
+                return sizeof(uint32_t) + value.size() * size_traits<Elem>::fixed_size;
+            } else {
+                size_t total = sizeof(uint32_t);
+                for (const auto& elem : value) {
+                    total += encoded_size(elem);
+                }
+                return total;
+            }
+        }
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            return sizeof(uint32_t) + std::string_view(value).size();
+        }
+        else if constexpr (std::is_convertible_v<const T&, std::span<const std::byte>>) {
+            return sizeof(uint32_t) + std::span<const std::byte>(value).size();
+        }
+        else if constexpr (has_size_traits_encoded_size<T>::value) {
+            return size_traits<T>::encoded_size(value);
+        }
+        else {
+            static_assert(sizeof(T) == 0,
+                          "bsatn::encoded_size: no size_traits for this type; specialize bsatn::size_traits<T>.");
+            return 0;
+        }
+    }
+
+    /**
+     * @brief Reserves the exact encoded size of `value` if `writer` is empty.
+     * @details Called at the start of generated `serialize()` functions so a top-level value is
+     *          written with a single allocation; nested calls (non-empty writer) skip the pre-pass.
+     */
+    template<typename T>
+    void reserve_encoded(Writer& writer, const T& value) {
+        if (writer.size() == 0) {
+            writer.reserve(encoded_size(value));
+        }
+    }
+
+} // namespace SpacetimeDb::bsatn
+
+#endif // SPACETIMEDB_BSATN_SIZE_H
@@ -0,0 +1,52 @@
+#ifndef SPACETIMEDB_BSATN_STREAMING_READER_H
+#define SPACETIMEDB_BSATN_STREAMING_READER_H
+
+#include "reader.h"
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace SpacetimeDb::bsatn {
+
+    /**
+     * @brief A Reader that pulls its input in chunks instead of holding all of it.
+     * @details Reads go through the usual inline Reader paths; only when the buffered window
+     *          runs short does the Reader call `pull` for more, keeping the unread tail. Peak
+     *          memory is one chunk plus the largest single string or byte array in the input
+     *          (bulk vectors are copied into their destination chunk by chunk).
+     *
+     *          Views returned by `read_string_view()` / `read_bytes_span()` are only valid until
+     *          the next read, since a refill may reuse the buffer. Decode owned values (or
+     *          copy the views) when reading from a StreamingReader.
+     */
+    class StreamingReader : public Reader {
+    public:
+        // Fills up to `dest.size()` bytes of `dest` and returns how many; 0 means end of input.
+        using PullFn = std::function<size_t(std::span<std::byte> dest)>;
+
+        static constexpr size_t default_chunk_size = 16 * 1024;
+
+        explicit StreamingReader(PullFn pull, ErrorMode mode = ErrorMode::Throw,
+                                 size_t chunk_size = default_chunk_size);
+
+        StreamingReader(const StreamingReader&) = delete;
+        StreamingReader& operator=(const StreamingReader&) = delete;
+
+        // True once every byte has been read, pulling if the buffer is empty.
+        bool is_eos();
+
+    private:
+        static bool refill_hook(Reader& reader, size_t count);
+        bool refill(size_t count);
+
+        PullFn pull_;
+        std::vector<std::byte> buffer_;
+        size_t chunk_size_;
+        bool source_done_ = false;
+    };
+
+} // namespace SpacetimeDb::bsatn
+
+#endif // SPACETIMEDB_BSATN_STREAMING_READER_H
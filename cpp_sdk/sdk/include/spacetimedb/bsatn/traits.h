@@ -0,0 +1,75 @@
+#ifndef SPACETIMEDB_BSATN_TRAITS_H
+#define SPACETIMEDB_BSATN_TRAITS_H
+
+#include <bit>         // For std::endian
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "wide_integers.h" // For u128 / i128 / u256 / i256
+
+namespace SpacetimeDb::bsatn {
+
+    /**
+     * @brief Set for structs whose memory layout is exactly their BSATN encoding.
+     * @details Specialized by SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS: true when the struct is
+     *          trivially copyable and standard-layout, and every field is itself bulk-copyable
+     *          and sits at the offset where BSATN puts it (declared order, no padding).
+     */
+    template<typename T>
+    struct is_bitwise_layout : std::false_type {};
+
+    /**
+     * @brief Whether a contiguous run of `T` has the same bytes in memory as in BSATN.
+     * @details True on a little-endian target for the fixed-width integers (including
+     *          `Types::u128` ... `Types::i256`), `float`, `double`, `std::byte` and structs with
+     *          `is_bitwise_layout`. Such values are written and read with one memcpy, and
+     *          `Writer::write_vector` / `Reader::read_vector` copy whole vectors of them at once.
+     *          `bool` is excluded because decoding must reject bytes other than 0 and 1.
+     */
+    template<typename T>
+    inline constexpr bool is_bulk_copyable_v =
+        std::endian::native == std::endian::little &&
+        (std::is_same_v<T, std::byte> ||
+         std::is_same_v<T, uint8_t> || std::is_same_v<T, int8_t> ||
+         std::is_same_v<T, uint16_t> || std::is_same_v<T, int16_t> ||
+         std::is_same_v<T, uint32_t> || std::is_same_v<T, int32_t> ||
+         std::is_same_v<T, uint64_t> || std::is_same_v<T, int64_t> ||
+         (std::is_same_v<T, float> && sizeof(float) == 4) ||
+         (std::is_same_v<T, double> && sizeof(double) == 8) ||
+         SpacetimeDb::Types::is_wide_integer_v<T> ||
+         is_bitwise_layout<T>::value);
+
+    /**
+     * @brief Set for structs with a field that is a view into the decoded buffer.
+     * @details Specialized by SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS from `is_borrowed_v` of each field.
+     */
+    template<typename T>
+    struct has_borrowed_fields : std::false_type {};
+
+    // See is_borrowed_v.
+    template<typename T> struct is_borrowed : has_borrowed_fields<T> {};
+    template<> struct is_borrowed<std::string_view> : std::true_type {};
+    template<> struct is_borrowed<std::span<const std::byte>> : std::true_type {};
+    template<typename T> struct is_borrowed<std::optional<T>> : is_borrowed<T> {};
+    template<typename T, typename A> struct is_borrowed<std::vector<T, A>> : is_borrowed<T> {};
+
+    /**
+     * @brief Whether a decoded `T` points into the buffer it was decoded from.
+     * @details True for `std::string_view`, `std::span<const std::byte>`, structs with such a
+     *          field, and optionals and vectors of these. Such values are only valid while that
+     *          buffer is alive and unmodified.
+     */
+    template<typename T>
+    inline constexpr bool is_borrowed_v = is_borrowed<std::remove_cvref_t<T>>::value;
+
+    template<typename> struct is_std_vector : std::false_type {};
+    template<typename T, typename A> struct is_std_vector<std::vector<T, A>> : std::true_type {};
+    template<typename T> inline constexpr bool is_std_vector_v = is_std_vector<T>::value;
+
+} // namespace SpacetimeDb::bsatn
+
+#endif // SPACETIMEDB_BSATN_TRAITS_H
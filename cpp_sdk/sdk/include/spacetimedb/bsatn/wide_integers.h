@@ -0,0 +1,309 @@
+#ifndef SPACETIMEDB_BSATN_WIDE_INTEGERS_H
+#define SPACETIMEDB_BSATN_WIDE_INTEGERS_H
+
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional> // For std::hash
+#include <string>
+#include <type_traits>
+
+// 128- and 256-bit integers for the SpacetimeDB `u128` / `i128` / `u256` / `i256` column types.
+// Their in-memory layout on a little-endian target is their BSATN encoding, so the codecs in
+// reader.h / writer.h move them with a single 16- or 32-byte copy.
+
+namespace SpacetimeDb {
+    namespace Types {
+
+        __extension__ typedef unsigned __int128 native_u128;
+        __extension__ typedef __int128 native_i128;
+
+        /**
+         * @brief 128-bit integer backed by the compiler's `__int128`.
+         * @tparam Native `native_u128` (u128) or `native_i128` (i128).
+         */
+        template<typename Native>
+        struct basic_int128 {
+            Native value = 0;
+
+            constexpr basic_int128() = default;
+            template<typename I, std::enable_if_t<std::is_integral_v<I>, int> = 0>
+            constexpr basic_int128(I v) : value(static_cast<Native>(v)) {}
+            constexpr explicit basic_int128(Native v, int /*raw*/) : value(v) {}
+
+            // `high * 2^64 + low`, in two's complement for i128.
+            static constexpr basic_int128 from_parts(uint64_t high, uint64_t low) {
+                return basic_int128((static_cast<Native>(static_cast<native_u128>(high) << 64)) | low, 0);
+            }
+            constexpr uint64_t low() const { return static_cast<uint64_t>(value); }
+            constexpr uint64_t high() const { return static_cast<uint64_t>(static_cast<native_u128>(value) >> 64); }
+            constexpr Native native() const { return value; }
+            constexpr explicit operator bool() const { return value != 0; }
+
+            friend constexpr basic_int128 operator+(basic_int128 a, basic_int128 b) { return basic_int128(wrap(a.value, b.value, '+'), 0); }
+            friend constexpr basic_int128 operator-(basic_int128 a, basic_int128 b) { return basic_int128(wrap(a.value, b.value, '-'), 0); }
+            friend constexpr basic_int128 operator*(basic_int128 a, basic_int128 b) { return basic_int128(wrap(a.value, b.value, '*'), 0); }
+            friend constexpr basic_int128 operator/(basic_int128 a, basic_int128 b) { return basic_int128(a.value / b.value, 0); }
+            friend constexpr basic_int128 operator%(basic_int128 a, basic_int128 b) { return basic_int128(a.value % b.value, 0); }
+            friend constexpr basic_int128 operator&(basic_int128 a, basic_int128 b) { return basic_int128(a.value & b.value, 0); }
+            friend constexpr basic_int128 operator|(basic_int128 a, basic_int128 b) { return basic_int128(a.value | b.value, 0); }
+            friend constexpr basic_int128 operator^(basic_int128 a, basic_int128 b) { return basic_int128(a.value ^ b.value, 0); }
+            friend constexpr basic_int128 operator<<(basic_int128 a, unsigned shift) {
+                return basic_int128(static_cast<Native>(static_cast<native_u128>(a.value) << shift), 0);
+            }
+            friend constexpr basic_int128 operator>>(basic_int128 a, unsigned shift) { return basic_int128(a.value >> shift, 0); }
+            constexpr basic_int128 operator~() const { return basic_int128(~value, 0); }
+            constexpr basic_int128 operator-() const { return basic_int128(0) - *this; }
+
+            constexpr basic_int128& operator+=(basic_int128 o) { return *this = *this + o; }
+            constexpr basic_int128& operator-=(basic_int128 o) { return *this = *this - o; }
+            constexpr basic_int128& operator*=(basic_int128 o) { return *this = *this * o; }
+            constexpr basic_int128& operator/=(basic_int128 o) { return *this = *this / o; }
+            constexpr basic_int128& operator%=(basic_int128 o) { return *this = *this % o; }
+            constexpr basic_int128& operator++() { return *this += 1; }
+            constexpr basic_int128& operator--() { return *this -= 1; }
+
+            friend constexpr bool operator==(basic_int128 a, basic_int128 b) { return a.value == b.value; }
+            friend constexpr std::strong_ordering operator<=>(basic_int128 a, basic_int128 b) {
+                return a.value < b.value ? std::strong_ordering::less
+                     : a.value > b.value ? std::strong_ordering::greater
+                     : std::strong_ordering::equal;
+            }
+
+            std::string to_string() const {
+                bool negative = value < 0;
+                native_u128 magnitude = negative ? native_u128(0) - static_cast<native_u128>(value) : static_cast<native_u128>(value);
+                std::string digits;
+                do {
+                    digits.insert(digits.begin(), static_cast<char>('0' + static_cast<int>(magnitude % 10)));
+                    magnitude /= 10;
+                } while (magnitude != 0);
+                return negative ? "-" + digits : digits;
+            }
+
+        private:
+            // Signed overflow wraps, as it does in the database, instead of being undefined.
+            static constexpr Native wrap(Native a, Native b, char op) {
+                native_u128 ua = static_cast<native_u128>(a), ub = static_cast<native_u128>(b);
+                native_u128 r = op == '+' ? ua + ub : op == '-' ? ua - ub : ua * ub;
+                return static_cast<Native>(r);
+            }
+        };
+
+        using u128 = basic_int128<native_u128>;
+        using i128 = basic_int128<native_i128>;
+
+        /**
+         * @brief 256-bit integer stored as four little-endian 64-bit limbs.
+         * @details Arithmetic wraps modulo 2^256; `i256` is two's complement. Division is a
+         *          plain shift-and-subtract loop, fine for occasional use on balances or hashes.
+         */
+        template<bool Signed>
+        struct basic_int256 {
+            std::array<uint64_t, 4> limbs{}; // limbs[0] is the least significant.
+
+            constexpr basic_int256() = default;
+            template<typename I, std::enable_if_t<std::is_integral_v<I>, int> = 0>
+            constexpr basic_int256(I v) {
+                limbs[0] = static_cast<uint64_t>(v);
+                uint64_t fill = 0;
+                if constexpr (std::is_signed_v<I>) {
+                    fill = v < 0 ? ~uint64_t{0} : 0;
+                }
+                limbs[1] = limbs[2] = limbs[3] = fill;
+            }
+            template<typename Native>
+            constexpr basic_int256(basic_int128<Native> v) {
+                limbs[0] = v.low();
+                limbs[1] = v.high();
+                uint64_t fill = (std::is_signed_v<Native> && v.value < 0) ? ~uint64_t{0} : 0;
+                limbs[2] = limbs[3] = fill;
+            }
+
+            static constexpr basic_int256 from_limbs(uint64_t l0, uint64_t l1, uint64_t l2, uint64_t l3) {
+                basic_int256 r;
+                r.limbs = {l0, l1, l2, l3};
+                return r;
+            }
+
+            constexpr bool is_negative() const { return Signed && (limbs[3] >> 63) != 0; }
+            constexpr explicit operator bool() const { return (limbs[0] | limbs[1] | limbs[2] | limbs[3]) != 0; }
+
+            friend constexpr basic_int256 operator+(const basic_int256& a, const basic_int256& b) {
+                basic_int256 r;
+                native_u128 carry = 0;
+                for (size_t i = 0; i < 4; ++i) {
+                    native_u128 sum = static_cast<native_u128>(a.limbs[i]) + b.limbs[i] + carry;
+                    r.limbs[i] = static_cast<uint64_t>(sum);
+                    carry = sum >> 64;
+                }
+                return r;
+            }
+            constexpr basic_int256 operator~() const {
+                return from_limbs(~limbs[0], ~limbs[1], ~limbs[2], ~limbs[3]);
+            }
+            constexpr basic_int256 operator-() const { return ~*this + basic_int256(1); }
+            friend constexpr basic_int256 operator-(const basic_int256& a, const basic_int256& b) { return a + -b; }
+
+            friend constexpr basic_int256 operator*(const basic_int256& a, const basic_int256& b) {
+                basic_int256 r;
+                for (size_t i = 0; i < 4; ++i) {
+                    native_u128 carry = 0;
+                    for (size_t j = 0; i + j < 4; ++j) {
+                        native_u128 cur = static_cast<native_u128>(a.limbs[i]) * b.limbs[j] + r.limbs[i + j] + carry;
+                        r.limbs[i + j] = static_cast<uint64_t>(cur);
+                        carry = cur >> 64;
+                    }
+                }
+                return r;
+            }
+
+            // Truncates toward zero, like the built-in integer types. Division by zero yields 0.
+            friend constexpr basic_int256 operator/(const basic_int256& a, const basic_int256& b) { return divmod(a, b).first; }
+            friend constexpr basic_int256 operator%(const basic_int256& a, const basic_int256& b) { return divmod(a, b).second; }
+
+            friend constexpr basic_int256 operator&(const basic_int256& a, const basic_int256& b) {
+                return from_limbs(a.limbs[0] & b.limbs[0], a.limbs[1] & b.limbs[1], a.limbs[2] & b.limbs[2], a.limbs[3] & b.limbs[3]);
+            }
+            friend constexpr basic_int256 operator|(const basic_int256& a, const basic_int256& b) {
+                return from_limbs(a.limbs[0] | b.limbs[0], a.limbs[1] | b.limbs[1], a.limbs[2] | b.limbs[2], a.limbs[3] | b.limbs[3]);
+            }
+            friend constexpr basic_int256 operator^(const basic_int256& a, const basic_int256& b) {
+                return from_limbs(a.limbs[0] ^ b.limbs[0], a.limbs[1] ^ b.limbs[1], a.limbs[2] ^ b.limbs[2], a.limbs[3] ^ b.limbs[3]);
+            }
+
+            friend constexpr basic_int256 operator<<(const basic_int256& a, unsigned shift) {
+                basic_int256 r;
+                if (shift >= 256) return r;
+                size_t limb_shift = shift / 64;
+                unsigned bit_shift = shift % 64;
+                for (size_t i = 3 + 1; i-- > limb_shift;) {
+                    uint64_t v = a.limbs[i - limb_shift] << bit_shift;
+                    if (bit_shift != 0 && i - limb_shift > 0) {
+                        v |= a.limbs[i - limb_shift - 1] >> (64 - bit_shift);
+                    }
+                    r.limbs[i] = v;
+                }
+                return r;
+            }
+            // Arithmetic shift for i256, logical for u256.
+            friend constexpr basic_int256 operator>>(const basic_int256& a, unsigned shift) {
+                uint64_t fill = a.is_negative() ? ~uint64_t{0} : 0;
+                basic_int256 r = from_limbs(fill, fill, fill, fill);
+                if (shift >= 256) return r;
+                size_t limb_shift = shift / 64;
+                unsigned bit_shift = shift % 64;
+                for (size_t i = 0; i + limb_shift < 4; ++i) {
+                    uint64_t hi = i + limb_shift + 1 < 4 ? a.limbs[i + limb_shift + 1] : fill;
+                    uint64_t v = a.limbs[i + limb_shift] >> bit_shift;
+                    if (bit_shift != 0) {
+                        v |= hi << (64 - bit_shift);
+                    }
+                    r.limbs[i] = v;
+                }
+                return r;
+            }
+
+            constexpr basic_int256& operator+=(const basic_int256& o) { return *this = *this + o; }
+            constexpr basic_int256& operator-=(const basic_int256& o) { return *this = *this - o; }
+            constexpr basic_int256& operator*=(const basic_int256& o) { return *this = *this * o; }
+            constexpr basic_int256& operator/=(const basic_int256& o) { return *this = *this / o; }
+            constexpr basic_int256& operator%=(const basic_int256& o) { return *this = *this % o; }
+            constexpr basic_int256& operator++() { return *this += basic_int256(1); }
+            constexpr basic_int256& operator--() { return *this -= basic_int256(1); }
+
+            friend constexpr bool operator==(const basic_int256& a, const basic_int256& b) { return a.limbs == b.limbs; }
+            friend constexpr std::strong_ordering operator<=>(const basic_int256& a, const basic_int256& b) {
+                if (a.is_negative() != b.is_negative()) {
+                    return a.is_negative() ? std::strong_ordering::less : std::strong_ordering::greater;
+                }
+                for (size_t i = 4; i-- > 0;) {
+                    if (a.limbs[i] != b.limbs[i]) {
+                        return a.limbs[i] < b.limbs[i] ? std::strong_ordering::less : std::strong_ordering::greater;
+                    }
+                }
+                return std::strong_ordering::equal;
+            }
+
+            std::string to_string() const {
+                bool negative = is_negative();
+                basic_int256<false> magnitude = basic_int256<false>::from_limbs(limbs[0], limbs[1], limbs[2], limbs[3]);
+                if (negative) {
+                    magnitude = -magnitude;
+                }
+                const basic_int256<false> chunk_divisor(uint64_t{10000000000000000000ULL}); // 10^19
+                std::string digits;
+                do {
+                    auto [quotient, remainder] = basic_int256<false>::divmod(magnitude, chunk_divisor);
+                    std::string chunk = std::to_string(remainder.limbs[0]);
+                    magnitude = quotient;
+                    if (magnitude) {
+                        chunk.insert(chunk.begin(), 19 - chunk.size(), '0');
+                    }
+                    digits.insert(0, chunk);
+                } while (magnitude);
+                return negative ? "-" + digits : digits;
+            }
+
+            static constexpr std::pair<basic_int256, basic_int256> divmod(const basic_int256& a, const basic_int256& b) {
+                if (!b) {
+                    return {basic_int256(), basic_int256()};
+                }
+                bool negate_quotient = a.is_negative() != b.is_negative();
+                bool negate_remainder = a.is_negative();
+                basic_int256<false> n = basic_int256<false>::from_limbs(a.limbs[0], a.limbs[1], a.limbs[2], a.limbs[3]);
+                basic_int256<false> d = basic_int256<false>::from_limbs(b.limbs[0], b.limbs[1], b.limbs[2], b.limbs[3]);
+                if (a.is_negative()) n = -n;
+                if (b.is_negative()) d = -d;
+
+                basic_int256<false> quotient, remainder;
+                for (size_t bit = 256; bit-- > 0;) {
+                    remainder = remainder << 1;
+                    remainder.limbs[0] |= (n.limbs[bit / 64] >> (bit % 64)) & 1;
+                    if (remainder >= d) {
+                        remainder -= d;
+                        quotient.limbs[bit / 64] |= uint64_t{1} << (bit % 64);
+                    }
+                }
+                basic_int256 q = from_limbs(quotient.limbs[0], quotient.limbs[1], quotient.limbs[2], quotient.limbs[3]);
+                basic_int256 r = from_limbs(remainder.limbs[0], remainder.limbs[1], remainder.limbs[2], remainder.limbs[3]);
+                return {negate_quotient ? -q : q, negate_remainder ? -r : r};
+            }
+        };
+
+        using u256 = basic_int256<false>;
+        using i256 = basic_int256<true>;
+
+        static_assert(sizeof(u128) == 16 && sizeof(i128) == 16, "u128 / i128 must be exactly 16 bytes");
+        static_assert(sizeof(u256) == 32 && sizeof(i256) == 32, "u256 / i256 must be exactly 32 bytes");
+
+        template<typename T> struct is_wide_integer : std::false_type {};
+        template<typename N> struct is_wide_integer<basic_int128<N>> : std::true_type {};
+        template<bool S> struct is_wide_integer<basic_int256<S>> : std::true_type {};
+        template<typename T> inline constexpr bool is_wide_integer_v = is_wide_integer<T>::value;
+
+    } // namespace Types
+} // namespace SpacetimeDb
+
+template<typename Native>
+struct std::hash<SpacetimeDb::Types::basic_int128<Native>> {
+    size_t operator()(const SpacetimeDb::Types::basic_int128<Native>& v) const noexcept {
+        uint64_t h = v.low() ^ (v.high() * 0x9E3779B97F4A7C15ULL);
+        return std::hash<uint64_t>{}(h);
+    }
+};
+
+template<bool Signed>
+struct std::hash<SpacetimeDb::Types::basic_int256<Signed>> {
+    size_t operator()(const SpacetimeDb::Types::basic_int256<Signed>& v) const noexcept {
+        uint64_t h = 0;
+        for (uint64_t limb : v.limbs) {
+            h = (h ^ limb) * 0x100000001B3ULL + 0x9E3779B97F4A7C15ULL;
+        }
+        return std::hash<uint64_t>{}(h);
+    }
+};
+
+#endif // SPACETIMEDB_BSATN_WIDE_INTEGERS_H
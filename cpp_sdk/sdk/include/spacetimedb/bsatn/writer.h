@@ -3,18 +3,29 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include <span>
 #include <cstdint>
 #include <stdexcept> // For std::runtime_error
+#include <cstring>   // For std::memcpy
+#include <limits>    // For std::numeric_limits
 #include <optional>
 #include <functional>  // Was used for Func, can be removed if Func is removed
 #include <type_traits> // For std::is_enum
 #include "uint128_placeholder.h" // Assumes this is in the same directory or accessible via include paths
+#include "traits.h" // For is_bulk_copyable_v
 #include "spacetimedb/sdk/spacetimedb_sdk_types.h" // For u256_placeholder, i256_placeholder
 
 namespace SpacetimeDb::bsatn {
 
+    class Writer;
+
+    // Types the generic `serialize` template encodes itself; everything else needs an overload.
+    template<typename T>
+    concept SelfSerializing = std::is_enum_v<T> || requires(const T& value, Writer& w) { value.bsatn_serialize(w); };
+
     // Forward declare the generic free function template for serialization
-    template<typename T> void serialize(class Writer& w, const T& value);
+    template<typename T> requires SelfSerializing<T> void serialize(Writer& w, const T& value);
 
     // Explicit overloads for primitives and common types
     inline void serialize(Writer& w, bool value);
@@ -30,10 +41,16 @@ namespace SpacetimeDb::bsatn {
     inline void serialize(Writer& w, int64_t value);
     inline void serialize(Writer& w, const SpacetimeDb::Types::int128_t_placeholder& value);
     inline void serialize(Writer& w, const SpacetimeDb::sdk::i256_placeholder& value);
+    inline void serialize(Writer& w, const SpacetimeDb::Types::u128& value);
+    inline void serialize(Writer& w, const SpacetimeDb::Types::i128& value);
+    inline void serialize(Writer& w, const SpacetimeDb::Types::u256& value);
+    inline void serialize(Writer& w, const SpacetimeDb::Types::i256& value);
     inline void serialize(Writer& w, float value);
     inline void serialize(Writer& w, double value);
     inline void serialize(Writer& w, const std::string& value);
+    inline void serialize(Writer& w, std::string_view value);
     inline void serialize(Writer& w, const std::vector<std::byte>& value);
+    inline void serialize(Writer& w, std::span<const std::byte> value);
 
     // Overloads for optionals and vectors that call Writer member functions
     template<typename T>
@@ -42,34 +59,87 @@ namespace SpacetimeDb::bsatn {
     template<typename T>
     inline void serialize(Writer& w, const std::vector<T>& vec);
 
+    // What a Writer over a caller-supplied buffer does when a write does not fit.
+    enum class OverflowPolicy : uint8_t {
+        Throw,      // Throw std::runtime_error (abort under SPACETIMEDB_NO_EXCEPTIONS); the bytes written so far are left in the buffer.
+        SpillToHeap // Copy what was written into an owned vector and continue there.
+    };
+
     class Writer {
     public:
+        // Writes into an owned, growable vector.
         Writer() = default;
 
-        void write_bool(bool value);
-        void write_u8(uint8_t value);
-        void write_u16_le(uint16_t value);
-        void write_u32_le(uint32_t value);
-        void write_u64_le(uint64_t value);
-        void write_u128_le(const SpacetimeDb::Types::uint128_t_placeholder& value);
+        /**
+         * @brief Writes into `external` instead of allocating.
+         * @details The span must outlive the Writer. With `OverflowPolicy::SpillToHeap`, a write
+         *          that does not fit moves the output to an owned vector; `view()` is valid in
+         *          either case, while `get_buffer()` / `take_buffer()` are only available once the
+         *          output lives in the owned vector.
+         */
+        explicit Writer(std::span<std::byte> external, OverflowPolicy policy = OverflowPolicy::Throw)
+            : external_(external.data()), external_capacity_(external.size()), overflow_policy_(policy) {}
 
-        void write_i8(int8_t value);
-        void write_i16_le(int16_t value);
-        void write_i32_le(int32_t value);
-        void write_i64_le(int64_t value);
-        void write_i128_le(const SpacetimeDb::Types::int128_t_placeholder& value);
+        // Primitives are inline so a run of writes compiles to stores into the buffer.
+        // BSATN is little-endian; on a little-endian target each value is copied as is.
+        void write_bool(bool value) { write_u8(value ? 1 : 0); }
+        void write_u8(uint8_t value) { write_bytes_raw(&value, sizeof(value)); }
+        void write_u16_le(uint16_t value) { write_bytes_raw(&value, sizeof(value)); }
+        void write_u32_le(uint32_t value) { write_bytes_raw(&value, sizeof(value)); }
+        void write_u64_le(uint64_t value) { write_bytes_raw(&value, sizeof(value)); }
+        void write_u128_le(const SpacetimeDb::Types::uint128_t_placeholder& value) {
+            write_u64_le(value.low);  // Little-endian: lower part first
+            write_u64_le(value.high);
+        }
+
+        void write_i8(int8_t value) { write_bytes_raw(&value, sizeof(value)); }
+        void write_i16_le(int16_t value) { write_bytes_raw(&value, sizeof(value)); }
+        void write_i32_le(int32_t value) { write_bytes_raw(&value, sizeof(value)); }
+        void write_i64_le(int64_t value) { write_bytes_raw(&value, sizeof(value)); }
+        void write_i128_le(const SpacetimeDb::Types::int128_t_placeholder& value) {
+            write_u64_le(value.low);  // Lower part as uint64_t
+            write_i64_le(value.high); // Higher part as int64_t to preserve sign representation
+        }
+
+        // Native wide integers: their layout is the wire layout, so each is a single store.
+        void write_u128_le(const SpacetimeDb::Types::u128& value) { write_bytes_raw(&value, sizeof(value)); }
+        void write_i128_le(const SpacetimeDb::Types::i128& value) { write_bytes_raw(&value, sizeof(value)); }
+        void write_u256_le(const SpacetimeDb::Types::u256& value) { write_bytes_raw(&value, sizeof(value)); }
+        void write_i256_le(const SpacetimeDb::Types::i256& value) { write_bytes_raw(&value, sizeof(value)); }
+
+        // Writes a value whose memory layout is its BSATN encoding (see is_bulk_copyable_v) as is.
+        template<typename T>
+        void write_bitwise(const T& value) {
+            static_assert(is_bulk_copyable_v<T>, "Writer::write_bitwise requires a bulk-copyable type.");
+            write_bytes_raw(&value, sizeof(value));
+        }
 
-        void write_f32_le(float value);
-        void write_f64_le(double value);
+        void write_f32_le(float value) { write_bytes_raw(&value, sizeof(value)); }
+        void write_f64_le(double value) { write_bytes_raw(&value, sizeof(value)); }
 
-        void write_string(const std::string& value);
-        void write_bytes(const std::vector<std::byte>& value);
+        void write_string(std::string_view value) {
+            if (value.size() > std::numeric_limits<uint32_t>::max()) [[unlikely]] {
+                throw_length_exceeds_u32("String length");
+            }
+            write_u32_le(static_cast<uint32_t>(value.size()));
+            write_bytes_raw(value.data(), value.size());
+        }
+        void write_bytes(std::span<const std::byte> value) {
+            if (value.size() > std::numeric_limits<uint32_t>::max()) [[unlikely]] {
+                throw_length_exceeds_u32("Byte vector size");
+            }
+            write_u32_le(static_cast<uint32_t>(value.size()));
+            write_bytes_raw(value.data(), value.size());
+        }
+        void write_bytes(const std::vector<std::byte>& value) { write_bytes(std::span<const std::byte>(value)); }
+        // Writes `value` as is, without a length prefix; the counterpart of Reader::read_fixed_bytes.
+        void write_fixed_bytes(std::span<const std::byte> value) { write_bytes_raw(value.data(), value.size()); }
 
         template<typename T> // Removed Func, will use SpacetimeDb::bsatn::serialize(w, T_val)
         void write_optional(const std::optional<T>& opt_value) { // Renamed from write_optional(Func)
             if (opt_value.has_value()) {
                 write_u8(1);
-                SpacetimeDb::bsatn::serialize(*this, *opt_value); // Use the generic free serialize
+                serialize(*this, *opt_value); // Unqualified, so ADL finds overloads declared after this header
             }
             else {
                 write_u8(0);
@@ -79,8 +149,14 @@ namespace SpacetimeDb::bsatn {
         template<typename T> // Removed Func, will use SpacetimeDb::bsatn::serialize(w, T_val)
         void write_vector(const std::vector<T>& vec) { // Renamed from write_vector(Func)
             write_u32_le(static_cast<uint32_t>(vec.size()));
-            for (const auto& item : vec) {
-                SpacetimeDb::bsatn::serialize(*this, item); // Use the generic free serialize
+            if constexpr (is_bulk_copyable_v<T>) {
+                if (!vec.empty()) {
+                    write_bytes_raw(vec.data(), vec.size() * sizeof(T)); // Memory layout == wire layout.
+                }
+            } else {
+                for (const auto& item : vec) {
+                    serialize(*this, item); // Unqualified, as in write_optional
+                }
             }
         }
 
@@ -89,16 +165,82 @@ namespace SpacetimeDb::bsatn {
         // Generic serialize member function (calls the free template function SpacetimeDb::bsatn::serialize<T>)
         template<typename T>
         void serialize_member(const T& value) { // Renamed to avoid conflict with free function
-            SpacetimeDb::bsatn::serialize(*this, value);
+            serialize(*this, value);
         }
 
         const std::vector<std::byte>& get_buffer() const;
         std::vector<std::byte>&& take_buffer();
 
+        // The bytes written so far, wherever they live.
+        std::span<const std::byte> view() const { return {data(), size()}; }
+        const std::byte* data() const { return external_ ? external_ : buffer.data(); }
+        std::byte* data() { return external_ ? external_ : buffer.data(); }
+        size_t size() const { return external_ ? external_size_ : buffer.size(); }
+
+        // True while writing into the caller-supplied span (i.e. it has not spilled).
+        bool uses_external_buffer() const { return external_ != nullptr; }
+
+        /**
+         * @brief Empties the Writer but keeps its storage, so it can be reused without allocating.
+         * @details A Writer that spilled to the heap keeps writing there.
+         */
+        void reset() {
+            buffer.clear();
+            external_size_ = 0;
+        }
+
+        // Pre-sizes the owned vector; no effect while writing into an external buffer.
+        void reserve(size_t capacity) {
+            if (!external_) buffer.reserve(capacity);
+        }
+
     private:
-        void write_bytes_raw(const void* data, size_t size);
+        void write_bytes_raw(const void* data, size_t size) {
+            if (size == 0) return;
+            if (external_) {
+                if (external_capacity_ - external_size_ >= size) [[likely]] {
+                    std::memcpy(external_ + external_size_, data, size);
+                    external_size_ += size;
+                    return;
+                }
+                if (overflow_external(data, size)) return; // Flushed (SinkWriter); else spilled to `buffer`, or threw.
+            }
+            const std::byte* bytes = static_cast<const std::byte*>(data);
+            buffer.insert(buffer.end(), bytes, bytes + size);
+        }
+
+        // Cold paths, defined out of line in writer.cpp.
+        bool overflow_external(const void* data, size_t size);
+        [[noreturn]] static void throw_length_exceeds_u32(const char* what);
         std::vector<std::byte> buffer;
 
+        std::byte* external_ = nullptr;
+        size_t external_capacity_ = 0;
+        size_t external_size_ = 0;
+        OverflowPolicy overflow_policy_ = OverflowPolicy::Throw;
+
+    protected:
+        /**
+         * @brief Receives the output when the external buffer fills up.
+         * @details Called with the buffered bytes (after which the buffer is emptied), and
+         *          directly with the data of a single write that is larger than the buffer.
+         */
+        using FlushHook = void (*)(Writer& writer, std::span<const std::byte> bytes);
+
+        Writer(std::span<std::byte> external, FlushHook hook)
+            : external_(external.data()), external_capacity_(external.size()), flush_hook_(hook) {}
+
+        // Hands the buffered bytes to the flush hook and empties the buffer.
+        void flush_external() {
+            if (external_size_ != 0) {
+                flush_hook_(*this, std::span<const std::byte>(external_, external_size_));
+                external_size_ = 0;
+            }
+        }
+
+    private:
+        FlushHook flush_hook_ = nullptr;
+
     public:
         // Inline implementations for 256-bit types
         inline void write_u256_le(const SpacetimeDb::sdk::u256_placeholder& value) {
@@ -113,43 +255,58 @@ namespace SpacetimeDb::bsatn {
     };
 
 
-    // Definition of the generic free function template for serialization.
-    // This is the primary entry point for serializing an object.
-    // It relies on specializations for specific types (primitives, user-defined structs/enums).
-    template<typename T>
+    // Definition of the generic free function template for serialization. Only enums and SDK
+    // types with a `bsatn_serialize` member get here; primitives and user structs (see
+    // SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS) have overloads of their own.
+    template<typename T> requires SelfSerializing<T>
     void serialize(Writer& w, const T& value) {
         // If T is an enum class, cast it to its underlying type (assumed u8 by macros)
         if constexpr (std::is_enum_v<T>) {
             w.write_u8(static_cast<uint8_t>(value));
         }
         else {
-            // This will fail to compile if no specialization or matching overload of
-            // `serialize(Writer&, const UserType&)` is found for T, which is good.
-            // The SDK macros generate global `SpacetimeDB::bsatn::serialize(Writer&, const UserType&)`
-            // which should be found via ADL if `value` is in that namespace, or if this template
-            // itself is in SpacetimeDB::bsatn.
-            // To ensure it works, let's assume this template is in `bsatn` and generated functions are in `SpacetimeDB::bsatn`.
-            // Or, we rely on ADL.
-            // For now, let's assume this generic serialize calls a specific, potentially overloaded, serialize_internal or similar.
-            // However, the previous Writer::serialize<T> called a free function `serialize(Writer&, const T&)`
-            // So this free function itself IS the one that needs specializations or further overloads.
-            // This primary template can serve as a fallback that static_asserts or gives a clear error.
-
-            // The macros generate `SpacetimeDB::bsatn::serialize(Writer& writer, const CppTypeName& value)`
-            // So, this generic `bsatn::serialize` will not be called for those.
-            // For primitives, we need explicit `bsatn::serialize(Writer&, const Primitive&)` overloads or specializations.
-
-            // This is a placeholder for types not covered by specific overloads/specializations.
-            // A common pattern is to have a helper struct: `serializer<T>::apply(w, value);`
-            // For now, this generic function will only handle enums directly. Other types *must* have an overload.
-            static_assert(!std::is_class_v<T> && !std::is_pointer_v<T>,
-                "No generic bsatn::serialize for arbitrary classes/pointers. Provide a specific overload or specialization for T, or ensure it's an enum.");
-            // If it's not an enum and not a class, what is it? A fundamental type.
-            // Fundamental types should have explicit overloads like bsatn::serialize(Writer&, int) etc.
-            // Let's remove the static_assert and assume overloads exist.
+            value.bsatn_serialize(w); // SDK types (Identity, Timestamp, ...) encode themselves.
         }
     }
 
+    inline void serialize(Writer& w, bool value) { w.write_bool(value); }
+    inline void serialize(Writer& w, uint8_t value) { w.write_u8(value); }
+    inline void serialize(Writer& w, uint16_t value) { w.write_u16_le(value); }
+    inline void serialize(Writer& w, uint32_t value) { w.write_u32_le(value); }
+    inline void serialize(Writer& w, uint64_t value) { w.write_u64_le(value); }
+    inline void serialize(Writer& w, const SpacetimeDb::Types::uint128_t_placeholder& value) { w.write_u128_le(value); }
+    inline void serialize(Writer& w, const SpacetimeDb::sdk::u256_placeholder& value) { w.write_u256_le(value); }
+    inline void serialize(Writer& w, int8_t value) { w.write_i8(value); }
+    inline void serialize(Writer& w, int16_t value) { w.write_i16_le(value); }
+    inline void serialize(Writer& w, int32_t value) { w.write_i32_le(value); }
+    inline void serialize(Writer& w, int64_t value) { w.write_i64_le(value); }
+    inline void serialize(Writer& w, const SpacetimeDb::Types::int128_t_placeholder& value) { w.write_i128_le(value); }
+    inline void serialize(Writer& w, const SpacetimeDb::sdk::i256_placeholder& value) { w.write_i256_le(value); }
+    inline void serialize(Writer& w, float value) { w.write_f32_le(value); }
+    inline void serialize(Writer& w, double value) { w.write_f64_le(value); }
+    inline void serialize(Writer& w, const std::string& value) { w.write_string(value); }
+    inline void serialize(Writer& w, const std::vector<std::byte>& value) { w.write_bytes(value); }
+
+    template<typename T>
+    inline void serialize(Writer& w, const std::optional<T>& opt_value) { w.write_optional(opt_value); }
+
+    template<typename T>
+    inline void serialize(Writer& w, const std::vector<T>& vec) { w.write_vector(vec); }
+
+    inline void serialize(Writer& w, const SpacetimeDb::Types::u128& value) { w.write_u128_le(value); }
+    inline void serialize(Writer& w, const SpacetimeDb::Types::i128& value) { w.write_i128_le(value); }
+    inline void serialize(Writer& w, const SpacetimeDb::Types::u256& value) { w.write_u256_le(value); }
+    inline void serialize(Writer& w, const SpacetimeDb::Types::i256& value) { w.write_i256_le(value); }
+
+    // Borrowed string and byte views are written exactly like their owning counterparts.
+    inline void serialize(Writer& w, std::string_view value) {
+        w.write_string(value);
+    }
+
+    inline void serialize(Writer& w, std::span<const std::byte> value) {
+        w.write_bytes(value);
+    }
+
     // Explicit overloads for primitives (could also be specializations of the template)
     // These are often provided by a bsatn_lib.h or similar from codegen.
     // For consistency with macros that generate `SpacetimeDB::bsatn::serialize`, these should also be in that namespace.
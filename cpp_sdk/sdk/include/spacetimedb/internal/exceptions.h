@@ -0,0 +1,42 @@
+#ifndef SPACETIMEDB_INTERNAL_EXCEPTIONS_H
+#define SPACETIMEDB_INTERNAL_EXCEPTIONS_H
+
+#include <cstdio>  // For std::fputs
+#include <cstdlib> // For std::abort
+#include <utility> // For std::forward
+
+// SPACETIMEDB_NO_EXCEPTIONS builds the SDK without `throw` or `try`: failures a reducer can
+// handle are reported through status / Result types (see spacetimedb/sdk/result.h), and the
+// remaining ones (broken invariants, host calls that cannot fail in a valid module) abort
+// the call. Defined by the SPACETIMEDB_NO_EXCEPTIONS toolchain option, or implied when the
+// compiler has exceptions disabled (-fno-exceptions).
+#if !defined(SPACETIMEDB_NO_EXCEPTIONS) && !defined(__cpp_exceptions) && !defined(__EXCEPTIONS)
+#define SPACETIMEDB_NO_EXCEPTIONS 1
+#endif
+
+namespace SpacetimeDb::Internal {
+
+    // Reports `what` on stderr and aborts; in a module this traps, and the host fails the call.
+    [[noreturn]] inline void fatal_error(const char* what) noexcept {
+        std::fputs("SpacetimeDB fatal error: ", stderr);
+        std::fputs(what, stderr);
+        std::fputs("\n", stderr);
+        std::abort();
+    }
+
+    /**
+     * @brief Throws `exception`, or passes its message to `fatal_error()` under SPACETIMEDB_NO_EXCEPTIONS.
+     * @details Used by the SDK for every failure that has no status or Result to go through.
+     */
+    template<typename E>
+    [[noreturn]] void raise(E&& exception) {
+#ifdef SPACETIMEDB_NO_EXCEPTIONS
+        fatal_error(exception.what());
+#else
+        throw std::forward<E>(exception);
+#endif
+    }
+
+} // namespace SpacetimeDb::Internal
+
+#endif // SPACETIMEDB_INTERNAL_EXCEPTIONS_H
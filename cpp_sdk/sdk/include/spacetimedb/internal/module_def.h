@@ -28,6 +28,7 @@ namespace SpacetimeDb {
             Unit = 0, Bool = 1, U8 = 2, U16 = 3, U32 = 4, U64 = 5, U128 = 6,
             I8 = 7, I16 = 8, I32 = 9, I64 = 10, I128 = 11,
             F32 = 12, F64 = 13, String = 14, Bytes = 15,
+            U256 = 16, I256 = 17,
         };
         void serialize(SpacetimeDb::bsatn::Writer& writer, const InternalPrimitiveType& value);
 
@@ -84,10 +85,41 @@ namespace SpacetimeDb {
         };
         void serialize(SpacetimeDb::bsatn::Writer& writer, const InternalTypeDef& def);
 
+        // Column position within a table's row type (spacetimedb_primitives::ColId).
+        using ColId = uint16_t;
+
+        // Corresponds to spacetimedb_lib::db::raw_def::v9::RawIndexAlgorithm
+        enum class InternalIndexAlgorithm : uint8_t {
+            BTree = 0, Hash = 1, Direct = 2,
+        };
+
+        struct InternalIndexDef {
+            Identifier name;                          // Canonical host name, `{table}_{cols}_idx_{algorithm}`.
+            std::optional<Identifier> accessor_name;  // Name given in SPACETIMEDB_INDEX, if any.
+            InternalIndexAlgorithm algorithm = InternalIndexAlgorithm::BTree;
+            std::vector<ColId> columns;               // Exactly one column for Direct.
+        };
+        void serialize(SpacetimeDb::bsatn::Writer& writer, const InternalIndexDef& def);
+
+        struct InternalUniqueConstraintDef {
+            Identifier name;                          // `{table}_{cols}_key`
+            std::vector<ColId> columns;
+        };
+        void serialize(SpacetimeDb::bsatn::Writer& writer, const InternalUniqueConstraintDef& def);
+
+        struct InternalSequenceDef {
+            Identifier name;                          // `{table}_{col}_seq`
+            ColId column;
+        };
+        void serialize(SpacetimeDb::bsatn::Writer& writer, const InternalSequenceDef& def);
+
         struct InternalTableDef {
             Identifier name;
             ScopedTypeName row_type_name;
             std::optional<Identifier> primary_key_field_name;
+            std::vector<InternalIndexDef> indexes;
+            std::vector<InternalUniqueConstraintDef> unique_constraints;
+            std::vector<InternalSequenceDef> sequences;
         };
         void serialize(SpacetimeDb::bsatn::Writer& writer, const InternalTableDef& def);
 
@@ -118,6 +150,10 @@ namespace SpacetimeDb {
         // This is what get_serialized_module_definition_bytes will call.
         // void serialize_module_def(bsatn::Writer& writer, const InternalModuleDef& def); // This is an alternative to free serialize()
 
+        // Builds the module definition and serializes it into `writer`, e.g. a bsatn::SinkWriter
+        // that streams it to the host (implementation in module_def_builder.cpp).
+        void write_module_definition(SpacetimeDb::bsatn::Writer& writer);
+
         // Declaration for getting the final bytes (implementation in module_def_builder.cpp)
         std::vector<std::byte> get_serialized_module_definition_bytes();
 
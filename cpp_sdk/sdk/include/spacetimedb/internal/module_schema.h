@@ -2,16 +2,17 @@
 #define SPACETIMEDB_INTERNAL_MODULE_SCHEMA_H
 
 #include "spacetimedb/bsatn/reader.h" // For bsatn::Reader
+#include "spacetimedb/sdk/result.h"   // For spacetimedb::sdk::ReducerResult
 
 #include <string>
 #include <vector>
 #include <variant>
-#include <functional> // For std::function
 #include <map>
 #include <cstddef> // For std::byte
+#include <cstdint>
 
-// Forward declarations within the namespace
-namespace bsatn { class Reader; } // Already included, but good practice if it were only forward needed by this header
+// Forward declarations
+namespace spacetimedb::sdk { class ReducerContext; }
 
 namespace SpacetimeDb {
     enum class ReducerKind {
@@ -84,9 +85,17 @@ namespace SpacetimeDb {
         std::variant<StructDefinition, EnumDefinition> definition;
     };
 
+    // Index algorithms the host can build. Values match the tags of `InternalIndexAlgorithm`.
+    enum class IndexAlgorithm : uint8_t {
+        BTree = 0,
+        Hash = 1,
+        Direct = 2 // Single unsigned integer column; the key is used as an array offset.
+    };
+
     struct IndexDefinition {
         std::string index_name;
         std::vector<std::string> column_field_names;
+        IndexAlgorithm algorithm = IndexAlgorithm::BTree;
         // bool is_unique_index = false; // Optional: Consider for future enhancement
     };
 
@@ -102,14 +111,34 @@ namespace SpacetimeDb {
     struct ReducerParameterDefinition {
         std::string name;
         TypeIdentifier type;
+        bool is_array = false; // The parameter is a Vec of `type`.
     };
 
+    // Reducer entry point generated by the SPACETIMEDB_REDUCER macros; decodes the arguments and
+    // calls the reducer, passing it the context if it takes one. Returns the reducer's error, if
+    // it returned a failed ReducerResult.
+    using ReducerInvoker = spacetimedb::sdk::ReducerResult (*)(spacetimedb::sdk::ReducerContext&, bsatn::Reader&);
+
     struct ReducerDefinition {
         std::string spacetime_name;
         std::string cpp_function_name;
         std::vector<ReducerParameterDefinition> parameters;
-        std::function<void(bsatn::Reader&)> invoker;
+        ReducerInvoker invoker = nullptr;
         ReducerKind kind = ReducerKind::None;
+        // Some arguments are views into the argument bytes (see bsatn::is_borrowed_v), so they
+        // must be decoded from one buffer that outlives the call, not streamed.
+        bool borrows_args = false;
+    };
+
+    /**
+     * @brief One slot of the dense reducer dispatch table, indexed by host reducer id.
+     * @details `invoker` is copied out of `definition` so the hot path in `__call_reducer__`
+     *          is a bounds check plus an indirect call.
+     */
+    struct ReducerDispatchEntry {
+        ReducerInvoker invoker = nullptr;
+        const ReducerDefinition* definition = nullptr;
+        bool borrows_args = false;
     };
 
     class ModuleSchema {
@@ -180,15 +209,40 @@ namespace SpacetimeDb {
         void register_reducer(const std::string& spacetimedb_name,
                               const std::string& cpp_func_name,
                               const std::vector<ReducerParameterDefinition>& params,
-                              std::function<void(bsatn::Reader&)> invoker_func,
-                              ReducerKind reducer_kind) {
+                              ReducerInvoker invoker_func,
+                              ReducerKind reducer_kind,
+                              bool borrows_args = false) {
             ReducerDefinition def;
             def.spacetime_name = spacetimedb_name;
             def.cpp_function_name = cpp_func_name;
             def.parameters = params;
-            def.invoker = std::move(invoker_func);
+            def.invoker = invoker_func;
             def.kind = reducer_kind;
+            def.borrows_args = borrows_args;
             reducers[spacetimedb_name] = def;
+            rebuild_reducer_dispatch();
+        }
+
+        /**
+         * @brief Reducers indexed by the id the host passes to `__call_reducer__`.
+         * @details Ids are positions in `reducers`, i.e. sorted by SpacetimeDB name, which is the
+         *          order `build_internal_module_def` emits them in. Registrations run during
+         *          static initialization in an unspecified order, so each one rebuilds the table;
+         *          it is complete before the host can call a reducer, and dispatch only indexes it.
+         */
+        const std::vector<ReducerDispatchEntry>& reducer_dispatch_table() const {
+            return reducer_dispatch_;
+        }
+
+        // Returns the dispatch entry for `reducer_id`, or nullptr if the id is out of range.
+        const ReducerDispatchEntry* reducer_by_id(uint32_t reducer_id) const {
+            return reducer_id < reducer_dispatch_.size() ? &reducer_dispatch_[reducer_id] : nullptr;
+        }
+
+        // Returns the host reducer id for `spacetimedb_name`, or UINT32_MAX if it is not registered.
+        uint32_t reducer_id(const std::string& spacetimedb_name) const {
+            auto it = reducer_ids_.find(spacetimedb_name);
+            return it == reducer_ids_.end() ? UINT32_MAX : it->second;
         }
 
         void register_filter(const std::string& filter_name, const std::string& sql_string) {
@@ -203,6 +257,20 @@ namespace SpacetimeDb {
         ModuleSchema() = default;
         ModuleSchema(const ModuleSchema&) = delete;
         ModuleSchema& operator=(const ModuleSchema&) = delete;
+
+        // Refills the dispatch table and the name-to-id map from `reducers`, in one pass.
+        void rebuild_reducer_dispatch() {
+            reducer_dispatch_.clear();
+            reducer_dispatch_.reserve(reducers.size());
+            reducer_ids_.clear();
+            for (const auto& pair : reducers) {
+                reducer_ids_.emplace(pair.first, static_cast<uint32_t>(reducer_dispatch_.size()));
+                reducer_dispatch_.push_back(ReducerDispatchEntry{pair.second.invoker, &pair.second, pair.second.borrows_args});
+            }
+        }
+
+        std::vector<ReducerDispatchEntry> reducer_dispatch_;
+        std::map<std::string, uint32_t> reducer_ids_;
     };
 } // namespace SpacetimeDb
 
@@ -0,0 +1,63 @@
+#ifndef SPACETIMEDB_INTERNAL_TABLE_IDS_H
+#define SPACETIMEDB_INTERNAL_TABLE_IDS_H
+
+#include "spacetimedb/abi/spacetimedb_abi.h" // For table_id_from_name
+
+#include <cstdint>
+#include <string_view>
+
+namespace SpacetimeDb {
+    namespace Internal {
+
+        /**
+         * @brief Per-row-type cache of the host table id for the table declared with SPACETIMEDB_TABLE.
+         * @details `name` is set during static registration. `id` is resolved lazily, by the first
+         *          `Database::get_table<T>()` call (the host only resolves names inside a transaction),
+         *          and reused by every later call.
+         */
+        template<typename T>
+        struct TableIdCache {
+            static inline std::string_view name{};
+            static inline uint32_t id = 0;
+            static inline bool resolved = false;
+            static inline bool ambiguous = false; // T backs more than one table; callers must name it.
+        };
+
+        /** @brief Looks up a table id by name. Returns the host status code (0 on success). */
+        inline uint16_t lookup_table_id(std::string_view name, uint32_t& out_id) {
+            ::TableId id{0};
+            ::Status status = table_id_from_name(reinterpret_cast<const uint8_t*>(name.data()),
+                                                 static_cast<uint32_t>(name.size()), &id);
+            if (status.inner == 0) {
+                out_id = id.inner;
+            }
+            return status.inner;
+        }
+
+        /** @brief Resolves `TableIdCache<T>` if it is not resolved yet. Returns the host status code. */
+        template<typename T>
+        uint16_t resolve_cached_table_id() {
+            using Cache = TableIdCache<T>;
+            if (Cache::resolved || Cache::name.empty()) {
+                return 0;
+            }
+            uint16_t status = lookup_table_id(Cache::name, Cache::id);
+            Cache::resolved = (status == 0);
+            return status;
+        }
+
+        /** @brief Called by SPACETIMEDB_TABLE during static initialization. */
+        template<typename T>
+        void register_table_id_cache(const char* table_name) {
+            using Cache = TableIdCache<T>;
+            if (!Cache::name.empty()) {
+                Cache::ambiguous = true;
+                return;
+            }
+            Cache::name = table_name;
+        }
+
+    } // namespace Internal
+} // namespace SpacetimeDb
+
+#endif // SPACETIMEDB_INTERNAL_TABLE_IDS_H
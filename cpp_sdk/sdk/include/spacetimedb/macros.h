@@ -2,10 +2,17 @@
 #define SPACETIMEDB_MACROS_H
 
 #include "spacetimedb/internal/module_schema.h"
+#include "spacetimedb/internal/table_ids.h"
 #include "spacetimedb/bsatn/reader.h"
 #include "spacetimedb/bsatn/writer.h"
+#include "spacetimedb/bsatn/size.h"
+#include "spacetimedb/bsatn/projection.h"
 
+#include <cstddef> // For offsetof
 #include <string>
+#include <string_view>
+#include <optional>
+#include <span>
 #include <vector>
 #include <utility>
 #include <tuple>
@@ -53,45 +60,129 @@ inline ::SpacetimeDb::FieldDefinition SPACETIMEDB_FIELD_INTERNAL(const char* nam
 #define SPACETIMEDB_FIELD_CUSTOM_OPTIONAL(FieldNameStr, UserDefinedTypeNameStr, IsUniqueBool, IsAutoIncBool) \
     ::SPACETIMEDB_FIELD_INTERNAL(FieldNameStr, ::SpacetimeDb::CoreType::UserDefined, UserDefinedTypeNameStr, true, IsUniqueBool, IsAutoIncBool)
 
-// Re-typed SPACETIMEDB_XX_SERIALIZE_FIELD
+namespace SpacetimeDb::bsatn {
+    // Per-field codecs of SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS. The generated functions are not
+    // templates, so the field kind is resolved here, where the branches not taken depend on the
+    // field type and are never instantiated.
+    template<bool IsOptional, bool IsVector, typename F>
+    void serialize_field(Writer& writer, const F& field) {
+        if constexpr (IsOptional) {
+            writer.write_optional(field);
+        } else if constexpr (IsVector) {
+            writer.write_vector(field);
+        } else {
+            serialize(writer, field);
+        }
+    }
+
+    // `CppType` is the type listed for the field: the element type of optional and vector fields.
+    template<typename CppType, bool IsOptional, bool IsVector, typename F>
+    void deserialize_field(Reader& reader, F& field) {
+        if constexpr (IsOptional) {
+            field = reader.read_optional<CppType>();
+        } else if constexpr (IsVector) {
+            field = reader.read_vector<CppType>();
+        } else {
+            field = deserialize<CppType>(reader);
+        }
+    }
+
+    template<typename CppType, bool IsOptional, bool IsVector>
+    void skip_field(Reader& reader) {
+        if constexpr (IsOptional) {
+            skip<std::optional<CppType>>(reader);
+        } else if constexpr (IsVector) {
+            skip<std::vector<CppType>>(reader);
+        } else {
+            skip<CppType>(reader);
+        }
+    }
+
+    // Decodes `field` if it is selected, otherwise skips over it.
+    template<typename CppType, bool IsOptional, bool IsVector, typename F>
+    void read_projected_field(Reader& reader, F& field, bool selected) {
+        if (selected) {
+            deserialize_field<CppType, IsOptional, IsVector>(reader, field);
+        } else {
+            skip_field<CppType, IsOptional, IsVector>(reader);
+        }
+    }
+
+    // Decodes `field` if it is the wanted one; returns whether it was.
+    template<typename CppType, bool IsOptional, bool IsVector, typename F>
+    bool read_field_if_at(Reader& reader, F& field, bool is_wanted) {
+        if (is_wanted) {
+            deserialize_field<CppType, IsOptional, IsVector>(reader, field);
+        }
+        return is_wanted;
+    }
+} // namespace SpacetimeDb::bsatn
+
 #define SPACETIMEDB_XX_SERIALIZE_FIELD(WRITER, VALUE_OBJ, CPP_TYPE, FIELD_NAME, IS_OPTIONAL, IS_VECTOR) \
-    if constexpr (IS_OPTIONAL) { \
-        (WRITER).write_optional((VALUE_OBJ).FIELD_NAME); \
-    } else if constexpr (IS_VECTOR) { \
-        (WRITER).write_vector((VALUE_OBJ).FIELD_NAME); \
+    ::SpacetimeDb::bsatn::serialize_field<IS_OPTIONAL, IS_VECTOR>((WRITER), (VALUE_OBJ).FIELD_NAME);
+
+#define SPACETIMEDB_XX_DESERIALIZE_FIELD(READER, VALUE_OBJ, CPP_TYPE, FIELD_NAME, IS_OPTIONAL, IS_VECTOR) \
+    ::SpacetimeDb::bsatn::deserialize_field<CPP_TYPE, IS_OPTIONAL, IS_VECTOR>((READER), (VALUE_OBJ).FIELD_NAME);
+
+// Field reader for fixed-size structs; the generated deserialize has already bounds-checked
+// the whole struct.
+#define SPACETIMEDB_XX_DESERIALIZE_FIXED_FIELD(READER, VALUE_OBJ, CPP_TYPE, FIELD_NAME, IS_OPTIONAL, IS_VECTOR) \
+    ::SpacetimeDb::bsatn::read_fixed_field((READER), (VALUE_OBJ).FIELD_NAME);
+
+// Accumulates a struct's fixed encoded size into TOTAL; clears IS_FIXED for variable-size fields.
+#define SPACETIMEDB_XX_FIXED_SIZE_FIELD(TOTAL, IS_FIXED, CPP_TYPE, FIELD_NAME, IS_OPTIONAL, IS_VECTOR) \
+    if constexpr (IS_OPTIONAL || IS_VECTOR || !::SpacetimeDb::bsatn::is_fixed_size_v<CPP_TYPE>) { \
+        (IS_FIXED) = false; \
     } else { \
-        SpacetimeDb::bsatn::serialize((WRITER), (VALUE_OBJ).FIELD_NAME); \
+        (TOTAL) += ::SpacetimeDb::bsatn::size_traits<CPP_TYPE>::fixed_size; \
     }
 
-// Re-typed SPACETIMEDB_XX_DESERIALIZE_FIELD
-#define SPACETIMEDB_XX_DESERIALIZE_FIELD(READER, VALUE_OBJ, CPP_TYPE, FIELD_NAME, IS_OPTIONAL, IS_VECTOR) \
-    if constexpr (IS_OPTIONAL) { \
-        (VALUE_OBJ).FIELD_NAME = (READER).read_optional<CPP_TYPE>(); \
-    } else if constexpr (IS_VECTOR) { \
-        (VALUE_OBJ).FIELD_NAME = (READER).read_vector<CPP_TYPE>(); \
+// Clears IS_BITWISE unless the field is stored exactly as it is encoded, right after the
+// previous one; used with the `bitwise_row_type` local of the generated is_bitwise_layout check.
+#define SPACETIMEDB_XX_BITWISE_FIELD(IS_BITWISE, OFFSET, CPP_TYPE, FIELD_NAME, IS_OPTIONAL, IS_VECTOR) \
+    if constexpr (IS_OPTIONAL || IS_VECTOR || \
+                  !std::is_same_v<CPP_TYPE, decltype(bitwise_row_type::FIELD_NAME)> || \
+                  !::SpacetimeDb::bsatn::is_bulk_copyable_v<CPP_TYPE>) { \
+        (IS_BITWISE) = false; \
     } else { \
-        if constexpr (std::is_same_v<CPP_TYPE, uint8_t>) { (VALUE_OBJ).FIELD_NAME = (READER).read_u8(); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, uint16_t>) { (VALUE_OBJ).FIELD_NAME = (READER).read_u16_le(); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, uint32_t>) { (VALUE_OBJ).FIELD_NAME = (READER).read_u32_le(); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, uint64_t>) { (VALUE_OBJ).FIELD_NAME = (READER).read_u64_le(); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, int8_t>) { (VALUE_OBJ).FIELD_NAME = (READER).read_i8(); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, int16_t>) { (VALUE_OBJ).FIELD_NAME = (READER).read_i16_le(); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, int32_t>) { (VALUE_OBJ).FIELD_NAME = (READER).read_i32_le(); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, int64_t>) { (VALUE_OBJ).FIELD_NAME = (READER).read_i64_le(); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, float>) { (VALUE_OBJ).FIELD_NAME = (READER).read_f32_le(); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, double>) { (VALUE_OBJ).FIELD_NAME = (READER).read_f64_le(); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, bool>) { (VALUE_OBJ).FIELD_NAME = (READER).read_bool(); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, std::string>) { (VALUE_OBJ).FIELD_NAME = (READER).read_string(); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, ::SpacetimeDb::sdk::Identity>) { (VALUE_OBJ).FIELD_NAME.bsatn_deserialize(READER); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, ::SpacetimeDb::sdk::Timestamp>) { (VALUE_OBJ).FIELD_NAME.bsatn_deserialize(READER); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, ::SpacetimeDb::Types::uint128_t_placeholder>) { (VALUE_OBJ).FIELD_NAME = (READER).read_u128_le(); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, ::SpacetimeDb::Types::int128_t_placeholder>) { (VALUE_OBJ).FIELD_NAME = (READER).read_i128_le(); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, ::SpacetimeDb::sdk::u256_placeholder>) { (VALUE_OBJ).FIELD_NAME.bsatn_deserialize(READER); } \
-        else if constexpr (std::is_same_v<CPP_TYPE, ::SpacetimeDb::sdk::i256_placeholder>) { (VALUE_OBJ).FIELD_NAME.bsatn_deserialize(READER); } \
-        else { \
-            (VALUE_OBJ).FIELD_NAME = SpacetimeDb::bsatn::deserialize<CPP_TYPE>(READER); \
-        } \
+        if (offsetof(bitwise_row_type, FIELD_NAME) != (OFFSET)) (IS_BITWISE) = false; \
+        (OFFSET) += sizeof(CPP_TYPE); \
+    }
+
+// Sets BORROWED if the field is a view into the decoded buffer (see bsatn::is_borrowed_v).
+#define SPACETIMEDB_XX_BORROWED_FIELD(BORROWED, UNUSED, CPP_TYPE, FIELD_NAME, IS_OPTIONAL, IS_VECTOR) \
+    (BORROWED) = (BORROWED) || ::SpacetimeDb::bsatn::is_borrowed_v<CPP_TYPE>;
+
+#define SPACETIMEDB_XX_ENCODED_SIZE_FIELD(TOTAL, VALUE_OBJ, CPP_TYPE, FIELD_NAME, IS_OPTIONAL, IS_VECTOR) \
+    (TOTAL) += ::SpacetimeDb::bsatn::encoded_size((VALUE_OBJ).FIELD_NAME);
+
+// Decodes the field if `field_mask` selects it and skips it otherwise; used with the locals of
+// the generated `deserialize_projected` function.
+#define SPACETIMEDB_XX_DESERIALIZE_PROJECTED_FIELD(READER, VALUE_OBJ, CPP_TYPE, FIELD_NAME, IS_OPTIONAL, IS_VECTOR) \
+    ::SpacetimeDb::bsatn::read_projected_field<CPP_TYPE, IS_OPTIONAL, IS_VECTOR>((READER), (VALUE_OBJ).FIELD_NAME, field_mask.selects(current_field++));
+
+#define SPACETIMEDB_XX_SKIP_FIELD(READER, UNUSED, CPP_TYPE, FIELD_NAME, IS_OPTIONAL, IS_VECTOR) \
+    ::SpacetimeDb::bsatn::skip_field<CPP_TYPE, IS_OPTIONAL, IS_VECTOR>(READER);
+
+#define SPACETIMEDB_XX_FIELD_INDEX(NAME, INDEX, CPP_TYPE, FIELD_NAME, IS_OPTIONAL, IS_VECTOR) \
+    if ((NAME) == #FIELD_NAME) return (INDEX); \
+    ++(INDEX);
+
+// Deserializes only the field at position `field_index`; used with the locals of the generated
+// `deserialize_field_at` function.
+#define SPACETIMEDB_XX_DESERIALIZE_FIELD_AT(READER, VALUE_OBJ, CPP_TYPE, FIELD_NAME, IS_OPTIONAL, IS_VECTOR) \
+    if (::SpacetimeDb::bsatn::read_field_if_at<CPP_TYPE, IS_OPTIONAL, IS_VECTOR>((READER), (VALUE_OBJ).FIELD_NAME, current_field++ == field_index)) return;
+
+/** @internal Positions of the auto-increment (sequence) fields among a struct's registered fields. */
+inline std::vector<size_t> SPACETIMEDB_GENERATED_FIELD_INDICES_INTERNAL(const std::vector< ::SpacetimeDb::FieldDefinition>& fields) {
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].is_auto_increment) {
+            indices.push_back(i);
+        }
     }
+    return indices;
+}
 
 // Schema-only struct registration (no BSATN generation)
 #define SPACETIMEDB_TYPE_STRUCT(CppTypeName, SanitizedCppTypeName, SpacetimeDbTypeNameStr, FieldsInitializerList) \
@@ -138,57 +229,82 @@ inline ::SpacetimeDb::FieldDefinition SPACETIMEDB_FIELD_INTERNAL(const char* nam
     }} /* SpacetimeDb::ModuleRegistration */
 
 
-#define SPACETIMEDB_TABLE(CppRowTypeName, SpacetimeDbTableNameStr, IsPublicBool, ScheduledReducerNameStr) \
-    namespace SpacetimeDb { namespace ModuleRegistration { \
-        struct RegisterTable_##CppRowTypeName##_##SpacetimedbNameStr { \
-            RegisterTable_##CppRowTypeName##_##SpacetimedbNameStr() { \
+// The registration structs below are named after a per-file counter, as table and column names are
+// string literals and row type names may be qualified; the anonymous namespace keeps them per file.
+// The scheduled reducer name may be omitted.
+#define SPACETIMEDB_TABLE(CppRowTypeName, SpacetimeDbTableNameStr, IsPublicBool, ...) \
+    SPACETIMEDB_TABLE_IMPL(__COUNTER__, CppRowTypeName, SpacetimeDbTableNameStr, IsPublicBool, "" __VA_ARGS__)
+
+#define SPACETIMEDB_TABLE_IMPL(Id, CppRowTypeName, SpacetimeDbTableNameStr, IsPublicBool, ScheduledReducerNameStr) \
+    namespace SpacetimeDb { namespace ModuleRegistration { namespace { \
+        struct SPACETIMEDB_PASTE(RegisterTable_, Id) { \
+            SPACETIMEDB_PASTE(RegisterTable_, Id)() { \
                 ::SpacetimeDb::ModuleSchema::instance().register_table( \
                     SPACETIMEDB_STRINGIFY(CppRowTypeName), \
                     SpacetimeDbTableNameStr, \
                     IsPublicBool, \
                     ScheduledReducerNameStr \
                 ); \
+                ::SpacetimeDb::Internal::register_table_id_cache<CppRowTypeName>(SpacetimeDbTableNameStr); \
             } \
         }; \
-        static RegisterTable_##CppRowTypeName##_##SpacetimedbNameStr register_table_##CppRowTypeName##_##SpacetimedbNameStr##_instance; \
-    }}
+        SPACETIMEDB_PASTE(RegisterTable_, Id) SPACETIMEDB_PASTE(register_table_instance_, Id); \
+    }}}
 
 #define SPACETIMEDB_PRIMARY_KEY(SpacetimeDbTableNameStr, FieldNameStr) \
-    namespace SpacetimeDb { namespace ModuleRegistration { \
-        struct SetPrimaryKey_Default_##FieldNameStr { \
-             SetPrimaryKey_Default_##FieldNameStr() { \
+    SPACETIMEDB_PRIMARY_KEY_IMPL(__COUNTER__, SpacetimeDbTableNameStr, FieldNameStr)
+
+#define SPACETIMEDB_PRIMARY_KEY_IMPL(Id, SpacetimeDbTableNameStr, FieldNameStr) \
+    namespace SpacetimeDb { namespace ModuleRegistration { namespace { \
+        struct SPACETIMEDB_PASTE(SetPrimaryKey_, Id) { \
+            SPACETIMEDB_PASTE(SetPrimaryKey_, Id)() { \
                 ::SpacetimeDb::ModuleSchema::instance().set_primary_key( \
                     SpacetimeDbTableNameStr, \
                     FieldNameStr \
                 ); \
             } \
         }; \
-        static SetPrimaryKey_Default_##FieldNameStr set_pk_##FieldNameStr##_instance; \
-    }}
+        SPACETIMEDB_PASTE(SetPrimaryKey_, Id) SPACETIMEDB_PASTE(set_pk_instance_, Id); \
+    }}}
 
-#define SPACETIMEDB_INDEX(SpacetimeDbTableNameStr, IndexNameStr, ColumnFieldNamesInitializerList) \
-    namespace SpacetimeDb { namespace ModuleRegistration { \
-        struct RegisterIndex_##SpacetimeDbTableNameStr##_##IndexNameStr { \
-            RegisterIndex_##SpacetimeDbTableNameStr##_##IndexNameStr() { \
+// The column list is variadic so a multi-column `{ "a", "b" }` list survives the preprocessor.
+#define SPACETIMEDB_INDEX(SpacetimeDbTableNameStr, IndexNameStr, ...) \
+    SPACETIMEDB_INDEX_WITH_ALGORITHM(SpacetimeDbTableNameStr, IndexNameStr, ::SpacetimeDb::IndexAlgorithm::BTree, __VA_ARGS__)
+
+#define SPACETIMEDB_INDEX_HASH(SpacetimeDbTableNameStr, IndexNameStr, ...) \
+    SPACETIMEDB_INDEX_WITH_ALGORITHM(SpacetimeDbTableNameStr, IndexNameStr, ::SpacetimeDb::IndexAlgorithm::Hash, __VA_ARGS__)
+
+// Direct indexes take exactly one unsigned integer column.
+#define SPACETIMEDB_INDEX_DIRECT(SpacetimeDbTableNameStr, IndexNameStr, ColumnFieldNameStr) \
+    SPACETIMEDB_INDEX_WITH_ALGORITHM(SpacetimeDbTableNameStr, IndexNameStr, ::SpacetimeDb::IndexAlgorithm::Direct, { ColumnFieldNameStr })
+
+#define SPACETIMEDB_INDEX_WITH_ALGORITHM(SpacetimeDbTableNameStr, IndexNameStr, Algorithm, ...) \
+    SPACETIMEDB_INDEX_IMPL(__COUNTER__, SpacetimeDbTableNameStr, IndexNameStr, Algorithm, __VA_ARGS__)
+
+#define SPACETIMEDB_INDEX_IMPL(Id, SpacetimeDbTableNameStr, IndexNameStr, Algorithm, ...) \
+    namespace SpacetimeDb { namespace ModuleRegistration { namespace { \
+        struct SPACETIMEDB_PASTE(RegisterIndex_, Id) { \
+            SPACETIMEDB_PASTE(RegisterIndex_, Id)() { \
                 ::SpacetimeDb::IndexDefinition index_def; \
                 index_def.index_name = IndexNameStr; \
-                std::vector<std::string> cols = ColumnFieldNamesInitializerList; \
+                std::vector<std::string> cols = __VA_ARGS__; \
                 index_def.column_field_names = std::move(cols); \
+                index_def.algorithm = Algorithm; \
                 ::SpacetimeDb::ModuleSchema::instance().add_index( \
                     SpacetimeDbTableNameStr, \
                     index_def \
                 ); \
             } \
         }; \
-        static RegisterIndex_##SpacetimeDbTableNameStr##_##IndexNameStr register_index_##SpacetimeDbTableNameStr##_##IndexNameStr##_instance; \
-    }}
+        SPACETIMEDB_PASTE(RegisterIndex_, Id) SPACETIMEDB_PASTE(register_index_instance_, Id); \
+    }}}
 
 
 #define SPACETIMEDB_REDUCER_PARAM(ParamNameStr, ParamCoreType) \
-    ::SpacetimeDb::SPACETIMEDB_REDUCER_PARAM_INTERNAL(ParamNameStr, ParamCoreType, nullptr)
+    ::SPACETIMEDB_REDUCER_PARAM_INTERNAL(ParamNameStr, ParamCoreType, nullptr)
 
 #define SPACETIMEDB_REDUCER_PARAM_CUSTOM(ParamNameStr, UserDefinedTypeNameStr) \
-    ::SpacetimeDb::SPACETIMEDB_REDUCER_PARAM_INTERNAL(ParamNameStr, ::SpacetimeDb::CoreType::UserDefined, UserDefinedTypeNameStr)
+    ::SPACETIMEDB_REDUCER_PARAM_INTERNAL(ParamNameStr, ::SpacetimeDb::CoreType::UserDefined, UserDefinedTypeNameStr)
 
 inline ::SpacetimeDb::ReducerParameterDefinition SPACETIMEDB_REDUCER_PARAM_INTERNAL(const char* name, ::SpacetimeDb::CoreType core_type, const char* user_defined_name) {
     ::SpacetimeDb::TypeIdentifier type_id;
@@ -208,21 +324,76 @@ inline ::SpacetimeDb::ReducerParameterDefinition SPACETIMEDB_REDUCER_PARAM_INTER
 #define SPACETIMEDB_REDUCER_ARG_DECLARE_HELPER(ParamCppType, ParamName, reader_instance) \
     ParamCppType ParamName = ::SpacetimeDb::bsatn::deserialize<ParamCppType>(reader_instance);
 
+namespace SpacetimeDb::Internal {
+    // Argument types of a reducer, as listed in its registration macro.
+    template<typename... Args>
+    struct reducer_args {};
+
+    // Whether any argument of a reducer is a view into the argument bytes.
+    template<typename... Args>
+    inline constexpr bool reducer_args_borrow_v = (::SpacetimeDb::bsatn::is_borrowed_v<Args> || ...);
+
+    // Calls a reducer returning either `void` or a `ReducerResult`, as a `ReducerResult`.
+    template<typename Fn, typename... Args>
+    ::spacetimedb::sdk::ReducerResult invoke_reducer(Fn& fn, Args&&... args) {
+        using Returned = std::invoke_result_t<Fn&, Args&&...>;
+        static_assert(std::is_void_v<Returned> || std::is_convertible_v<Returned, ::spacetimedb::sdk::ReducerResult>,
+                      "A reducer must return void or spacetimedb::sdk::ReducerResult.");
+        if constexpr (std::is_void_v<Returned>) {
+            fn(std::forward<Args>(args)...);
+            return {};
+        } else {
+            return fn(std::forward<Args>(args)...);
+        }
+    }
+
+    /**
+     * @brief Decodes a reducer's arguments in order and calls it, preceded by the context if it takes one.
+     * @details Each argument is a local of its own frame (these calls inline away), so values
+     *          are moved into the reducer without going through a tuple. Types are decoded
+     *          without cv/ref qualifiers, so `const std::string&` may be listed as well.
+     *          `std::string_view` and `std::span<const std::byte>` arguments point into the
+     *          argument bytes, which outlive the call. Nothing is called if decoding failed.
+     * @return The reducer's result; success if it returns `void` or was not called.
+     */
+    template<typename Fn, typename... Decoded>
+    ::spacetimedb::sdk::ReducerResult decode_and_call(Fn& fn, ::spacetimedb::sdk::ReducerContext& ctx,
+                                                      ::SpacetimeDb::bsatn::Reader& reader,
+                                                      reducer_args<>, Decoded&... decoded) {
+        if (!reader.ok()) return {}; // Malformed arguments; the caller reports reader.error().
+        if constexpr (std::is_invocable_v<Fn&, ::spacetimedb::sdk::ReducerContext&, Decoded&&...>) {
+            return invoke_reducer(fn, ctx, std::move(decoded)...);
+        } else {
+            return invoke_reducer(fn, std::move(decoded)...);
+        }
+    }
+
+    template<typename Fn, typename Arg, typename... Rest, typename... Decoded>
+    ::spacetimedb::sdk::ReducerResult decode_and_call(Fn& fn, ::spacetimedb::sdk::ReducerContext& ctx,
+                                                      ::SpacetimeDb::bsatn::Reader& reader,
+                                                      reducer_args<Arg, Rest...>, Decoded&... decoded) {
+        std::remove_cvref_t<Arg> arg = ::SpacetimeDb::bsatn::deserialize<std::remove_cvref_t<Arg>>(reader);
+        return decode_and_call(fn, ctx, reader, reducer_args<Rest...>{}, decoded..., arg);
+    }
+} // namespace SpacetimeDb::Internal
+
 #define SPACETIMEDB_REGISTER_REDUCER_SCHEMA(SpacetimedbNameStr, CppFunctionName, Kind, RegParamsInitializerList, ...) \
     namespace SpacetimeDb { namespace ModuleRegistration { \
         struct RegisterReducer_##CppFunctionName { \
             RegisterReducer_##CppFunctionName() { \
-                auto invoker_lambda = [](::SpacetimeDb::bsatn::Reader& reader_param) { \
-                    std::tuple<__VA_ARGS__> args_tuple = \
-                        std::make_tuple(SpacetimeDb::bsatn::deserialize<__VA_ARGS__>(reader_param)...); \
-                    std::apply(CppFunctionName, args_tuple); \
+                ::SpacetimeDb::ReducerInvoker invoker_fn = [](::spacetimedb::sdk::ReducerContext& ctx, \
+                                                              ::SpacetimeDb::bsatn::Reader& reader_param) \
+                                                              -> ::spacetimedb::sdk::ReducerResult { \
+                    return ::SpacetimeDb::Internal::decode_and_call(CppFunctionName, ctx, reader_param, \
+                        ::SpacetimeDb::Internal::reducer_args<__VA_ARGS__>{}); \
                 }; \
                 ::SpacetimeDb::ModuleSchema::instance().register_reducer( \
                     SpacetimedbNameStr, \
                     SPACETIMEDB_STRINGIFY(CppFunctionName), \
                     std::vector< ::SpacetimeDb::ReducerParameterDefinition> RegParamsInitializerList, \
-                    invoker_lambda, \
-                    Kind \
+                    invoker_fn, \
+                    Kind, \
+                    ::SpacetimeDb::Internal::reducer_args_borrow_v<__VA_ARGS__> \
                 ); \
             } \
         }; \
@@ -282,15 +453,108 @@ inline ::SpacetimeDb::ReducerParameterDefinition SPACETIMEDB_REDUCER_PARAM_INTER
         static SPACETIMEDB_PASTE(Register, SanitizedCppTypeName) SPACETIMEDB_PASTE(register_, SPACETIMEDB_PASTE(SanitizedCppTypeName, _instance)); \
     }} /* SpacetimeDb::ModuleRegistration */ \
     namespace SpacetimeDb::bsatn { /* Functions in SpacetimeDb::bsatn namespace */ \
+            template<> \
+            struct size_traits<_actual_cpp_type_name_> { \
+                static constexpr std::pair<bool, size_t> fixed_info = []() constexpr { \
+                    size_t total = 0; \
+                    bool is_fixed = true; \
+                    FIELDS_MACRO(SPACETIMEDB_XX_FIXED_SIZE_FIELD, total, is_fixed); \
+                    return std::pair<bool, size_t>(is_fixed, is_fixed ? total : 0); \
+                }(); \
+                static constexpr bool is_fixed = fixed_info.first; \
+                static constexpr size_t fixed_size = fixed_info.second; \
+                static size_t encoded_size(const _actual_cpp_type_name_& value) { \
+                    if constexpr (is_fixed) { \
+                        (void)value; \
+                        return fixed_size; \
+                    } else { \
+                        size_t total = 0; \
+                        FIELDS_MACRO(SPACETIMEDB_XX_ENCODED_SIZE_FIELD, total, value); \
+                        return total; \
+                    } \
+                } \
+            }; \
+            template<> \
+            struct has_borrowed_fields<_actual_cpp_type_name_> : std::bool_constant<[]() constexpr { \
+                bool borrowed = false; \
+                FIELDS_MACRO(SPACETIMEDB_XX_BORROWED_FIELD, borrowed, 0); \
+                return borrowed; \
+            }()> {}; \
+            /* Generic lambda so the field checks (offsetof) are only instantiated for suitable types. */ \
+            template<> \
+            struct is_bitwise_layout<_actual_cpp_type_name_> : std::bool_constant<[](auto* row_ptr) constexpr { \
+                using bitwise_row_type = std::remove_pointer_t<decltype(row_ptr)>; \
+                if constexpr (!size_traits<bitwise_row_type>::is_fixed || \
+                              sizeof(bitwise_row_type) != size_traits<bitwise_row_type>::fixed_size || \
+                              !std::is_trivially_copyable_v<bitwise_row_type> || \
+                              !std::is_standard_layout_v<bitwise_row_type>) { \
+                    return false; \
+                } else { \
+                    bool is_bitwise = true; \
+                    size_t offset = 0; \
+                    FIELDS_MACRO(SPACETIMEDB_XX_BITWISE_FIELD, is_bitwise, offset); \
+                    return is_bitwise; \
+                } \
+            }(static_cast<_actual_cpp_type_name_*>(nullptr))> {}; \
             inline void serialize(::SpacetimeDb::bsatn::Writer& writer, const _actual_cpp_type_name_& value) { \
-                FIELDS_MACRO(SPACETIMEDB_XX_SERIALIZE_FIELD, writer, value); \
+                if constexpr (is_bitwise_layout<_actual_cpp_type_name_>::value) { \
+                    writer.write_bitwise(value); \
+                } else { \
+                    ::SpacetimeDb::bsatn::reserve_encoded(writer, value); \
+                    FIELDS_MACRO(SPACETIMEDB_XX_SERIALIZE_FIELD, writer, value); \
+                } \
         } \
             template<> \
                 inline _actual_cpp_type_name_ deserialize<_actual_cpp_type_name_>(::SpacetimeDb::bsatn::Reader& reader) { \
                 _actual_cpp_type_name_ obj{}; \
-                FIELDS_MACRO(SPACETIMEDB_XX_DESERIALIZE_FIELD, reader, obj); \
+                if constexpr (is_bitwise_layout<_actual_cpp_type_name_>::value) { \
+                    if (reader.ensure_bytes(sizeof(obj))) obj = reader.read_unchecked<_actual_cpp_type_name_>(); \
+                } else if constexpr (size_traits<_actual_cpp_type_name_>::is_fixed) { \
+                    if (!reader.ensure_bytes(size_traits<_actual_cpp_type_name_>::fixed_size)) return obj; \
+                    FIELDS_MACRO(SPACETIMEDB_XX_DESERIALIZE_FIXED_FIELD, reader, obj); \
+                } else { \
+                    FIELDS_MACRO(SPACETIMEDB_XX_DESERIALIZE_FIELD, reader, obj); \
+                } \
+                return obj; \
+            } \
+            template<> \
+                inline void skip<_actual_cpp_type_name_>(::SpacetimeDb::bsatn::Reader& reader) { \
+                if constexpr (size_traits<_actual_cpp_type_name_>::is_fixed) { \
+                    reader.skip_bytes(size_traits<_actual_cpp_type_name_>::fixed_size); \
+                } else { \
+                    FIELDS_MACRO(SPACETIMEDB_XX_SKIP_FIELD, reader, 0); \
+                } \
+            } \
+            template<> \
+                inline size_t field_index<_actual_cpp_type_name_>(std::string_view name) { \
+                size_t index = 0; \
+                FIELDS_MACRO(SPACETIMEDB_XX_FIELD_INDEX, name, index); \
+                return no_field_index; \
+            } \
+            template<> \
+                inline _actual_cpp_type_name_ deserialize_projected<_actual_cpp_type_name_>(::SpacetimeDb::bsatn::Reader& reader, FieldMask field_mask) { \
+                if (field_mask.is_all()) { \
+                    return deserialize<_actual_cpp_type_name_>(reader); \
+                } \
+                _actual_cpp_type_name_ obj{}; \
+                size_t current_field = 0; \
+                FIELDS_MACRO(SPACETIMEDB_XX_DESERIALIZE_PROJECTED_FIELD, reader, obj); \
+                (void)current_field; \
                 return obj; \
             } \
+            inline void deserialize_field_at(::SpacetimeDb::bsatn::Reader& reader, _actual_cpp_type_name_& obj, size_t field_index) { \
+                size_t current_field = 0; \
+                FIELDS_MACRO(SPACETIMEDB_XX_DESERIALIZE_FIELD_AT, reader, obj); \
+                (void)current_field; (void)field_index; \
+            } \
+            template<> \
+                inline void apply_generated_columns<_actual_cpp_type_name_>(::SpacetimeDb::bsatn::Reader& reader, _actual_cpp_type_name_& obj) { \
+                static const std::vector<size_t> generated_fields = \
+                    ::SPACETIMEDB_GENERATED_FIELD_INDICES_INTERNAL(std::vector< ::SpacetimeDb::FieldDefinition> RegFieldsInitializerList); \
+                for (size_t field_index : generated_fields) { \
+                    deserialize_field_at(reader, obj, field_index); \
+                } \
+            } \
         }
 
 #endif // SPACETIMEDB_MACROS_H
@@ -0,0 +1,53 @@
+#ifndef SPACETIMEDB_SDK_BATCH_REDUCER_H
+#define SPACETIMEDB_SDK_BATCH_REDUCER_H
+
+#include "spacetimedb/bsatn/reader.h"           // For bsatn::Reader
+#include "spacetimedb/internal/module_schema.h" // For SpacetimeDb::ModuleSchema
+#include "spacetimedb/sdk/result.h"             // For spacetimedb::sdk::ReducerResult
+
+#include <cstdint>
+#include <string>
+
+namespace spacetimedb::sdk { class ReducerContext; }
+
+namespace SpacetimeDb::Internal {
+
+    // Name of the `(reducer_id, args)` element type of a batch reducer's parameter.
+    inline constexpr const char* batch_call_type_name = "BatchCall";
+
+    /**
+     * @brief Invoker of the batch reducer: runs each `(reducer_id, args)` entry of its
+     *        `Vec<BatchCall>` argument through the reducer dispatch table, in order.
+     * @details All entries share the batch's context and transaction. The first failing entry
+     *          stops the batch and fails it, so the host rolls back the entries before it too;
+     *          the error reads `batch[<index>] <reducer name>: <message>` and keeps the entry's
+     *          error code. Lifecycle reducers and nested batches are rejected.
+     */
+    ::spacetimedb::sdk::ReducerResult invoke_batch(::spacetimedb::sdk::ReducerContext& ctx,
+                                                   ::SpacetimeDb::bsatn::Reader& reader);
+
+    // Registers `invoke_batch` as the reducer `spacetimedb_name`, along with the BatchCall type.
+    void register_batch_reducer(const std::string& spacetimedb_name);
+
+} // namespace SpacetimeDb::Internal
+
+/**
+ * @brief Adds a reducer that runs many reducer calls in one transaction.
+ * @details Its single parameter `calls` is a `Vec<BatchCall>`, where `BatchCall` is the
+ *          product `{ reducer_id: u32, args: bytes }`: `reducer_id` is the id the host would
+ *          pass to `__call_reducer__` (the reducer's position in the module's reducer list) and
+ *          `args` its BSATN-encoded arguments. Clients sending many small calls per frame
+ *          (position updates, ...) pay the per-call host overhead once per batch.
+ *          @code
+ *          SPACETIMEDB_REDUCER_BATCH("batch");
+ *          @endcode
+ */
+#define SPACETIMEDB_REDUCER_BATCH(SpacetimedbNameStr) \
+    namespace SpacetimeDb { namespace ModuleRegistration { \
+        struct RegisterBatchReducer { \
+            RegisterBatchReducer() { ::SpacetimeDb::Internal::register_batch_reducer(SpacetimedbNameStr); } \
+        }; \
+        static RegisterBatchReducer register_batch_reducer_instance; \
+    }}
+
+#endif // SPACETIMEDB_SDK_BATCH_REDUCER_H
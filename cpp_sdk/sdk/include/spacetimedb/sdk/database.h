@@ -4,8 +4,11 @@
 #include <string>
 #include <stdexcept> // For std::runtime_error
 #include <spacetimedb/sdk/table.h> // For Table<T>
+#include <spacetimedb/sdk/result.h> // For Result, Error
 #include <spacetimedb/abi/spacetimedb_abi.h> // For ABI function calls
-#include <spacetimedb/bsatn/bsatn.h> // For BsatnSerializable concept (implicitly via Table<T>)
+#include <spacetimedb/bsatn/bsatn.h> // For the bsatn::Codec concept (implicitly via Table<T>)
+#include <spacetimedb/internal/table_ids.h> // For TableIdCache<T>
+#include <spacetimedb/internal/module_schema.h> // For the primary key looked up by table_delete_by_pk
 
 namespace spacetimedb {
 namespace sdk {
@@ -14,8 +17,49 @@ class Database {
 public:
     Database();
 
+    /**
+     * @brief Returns the table declared for `T` with SPACETIMEDB_TABLE.
+     * @details The table id is resolved by the first call (inside a transaction) and cached per
+     *          type, so later calls make no host call and allocate nothing.
+     * @throws std::runtime_error if `T` has no table, backs several tables, or the id cannot be resolved.
+     */
+    template<typename T>
+    Table<T> get_table() {
+        return detail::value_or_raise(try_get_table<T>());
+    }
+
     template<typename T>
     Table<T> get_table(const std::string& table_name) {
+        return detail::value_or_raise(try_get_table<T>(table_name));
+    }
+
+    // Non-throwing `get_table()`, for SPACETIMEDB_NO_EXCEPTIONS builds.
+    template<typename T>
+    Result<Table<T>> try_get_table() {
+        using Cache = SpacetimeDb::Internal::TableIdCache<T>;
+        if (!Cache::resolved) {
+            if (Cache::name.empty()) {
+                return Error{"Database::get_table: row type is not registered with SPACETIMEDB_TABLE"};
+            }
+            if (Cache::ambiguous) {
+                return Error{"Database::get_table: row type backs several tables; call get_table<T>(name)"};
+            }
+            uint16_t status = SpacetimeDb::Internal::resolve_cached_table_id<T>();
+            if (status != 0) {
+                return Error{"Database::get_table: table_id_from_name ABI call failed for table '" +
+                             std::string(Cache::name) + "' with error code " + std::to_string(status), status};
+            }
+        }
+        return Table<T>(Cache::id);
+    }
+
+    template<typename T>
+    Result<Table<T>> try_get_table(const std::string& table_name) {
+        using Cache = SpacetimeDb::Internal::TableIdCache<T>;
+        if (!Cache::ambiguous && Cache::name == table_name) {
+            return try_get_table<T>(); // Cached after the first resolution.
+        }
+
         // ABI: uint16_t _get_table_id(const uint8_t *name_ptr, size_t name_len, uint32_t *out_table_id_ptr)
 
         uint32_t table_id = 0;
@@ -26,14 +70,14 @@ public:
         );
 
         if (error_code != 0) {
-            throw std::runtime_error("Database::get_table: _get_table_id ABI call failed for table '" +
-                                     table_name + "' with error code " + std::to_string(error_code));
+            return Error{"Database::get_table: _get_table_id ABI call failed for table '" +
+                         table_name + "' with error code " + std::to_string(error_code), error_code};
         }
 
         // It's possible that an error_code of 0 still means "not found" if table_id is a sentinel like 0.
         // This depends on the ABI contract for _get_table_id. Assuming 0 is an invalid ID if no error.
         if (table_id == 0 && error_code == 0) {
-            throw std::runtime_error("Table not found: " + table_name + " (table_id resolved to 0 without ABI error)");
+            return Error{"Table not found: " + table_name + " (table_id resolved to 0 without ABI error)"};
         }
 
         return Table<T>(table_id);
@@ -45,58 +89,59 @@ public:
 
 /**
  * @brief Inserts a row into the specified table.
- * @details This function serializes the provided `row_data` object into BSATN format
- *          and calls the host environment to perform the table insertion.
- * @tparam TRow The C++ type of the row. A corresponding `SpacetimeDB::bsatn::serialize` function must exist
+ * @details Resolves the table by name and inserts `row_data` through `Table<TRow>::try_insert`.
+ * @tparam TRow The C++ type of the row. A corresponding `SpacetimeDb::bsatn::serialize` function must exist
  *              (typically generated by SDK macros).
  * @param table_name The name of the target table in the SpacetimeDB schema.
  * @param row_data The row object to insert.
- * @return `true` if the host reported success (Status code 0), `false` otherwise.
+ * @return `true` if the table was found and the host reported success, `false` otherwise.
  * @ingroup sdk_database sdk_table_ops
  */
 template<typename TRow>
 bool table_insert(const std::string& table_name, const TRow& row_data) {
-    // Assumes SpacetimeDB::bsatn::serialize is available for TRow
-    // and that bsatn::Writer is included via bsatn/bsatn.h (which should be pulled in by spacetimedb_abi.h or other sdk headers)
-    // If not, #include <spacetimedb/bsatn/bsatn.h> might be needed here.
-    // And #include <spacetimedb/abi/common_defs.h> for Status
-
-    bsatn::Writer writer;
-    SpacetimeDB::bsatn::serialize(writer, row_data);
-    const auto& buffer = writer.get_buffer();
-
-    ::Status status = ::table_insert( // Calls the C ABI function from spacetimedb_abi.h
-        reinterpret_cast<const uint8_t*>(table_name.c_str()),
-        static_cast<uint32_t>(table_name.length()),
-        reinterpret_cast<const unsigned char*>(buffer.data()), // ABI expects unsigned char*
-        static_cast<uint32_t>(buffer.size())
-    );
-    return status.inner == 0; // Assumes 0 is OK
+    Result<Table<TRow>> table = Database().try_get_table<TRow>(table_name);
+    if (!table) {
+        return false;
+    }
+    TRow row = row_data; // try_insert writes generated columns back into the row.
+    return table.value().try_insert(row).ok();
 }
 
 /**
  * @brief Deletes a row from the specified table using its primary key.
- * @details This function serializes the provided `pk_value` into BSATN format
- *          and calls the host environment to perform the deletion.
- * @tparam TPK The C++ type of the primary key. A corresponding `SpacetimeDB::bsatn::serialize` function must exist.
+ * @details The primary key is the one declared with SPACETIMEDB_PRIMARY_KEY; the row is deleted
+ *          through the btree index the ModuleDef gives it, `{table}_{column}_idx_btree`.
+ * @tparam TPK The C++ type of the primary key. A corresponding `SpacetimeDb::bsatn::serialize` function must exist.
  * @param table_name The name of the target table in the SpacetimeDB schema.
  * @param pk_value The primary key value of the row to delete.
- * @return `true` if the host reported success (Status code 0), `false` otherwise.
+ * @return `true` if the table has a primary key and the host reported success, `false` otherwise.
  * @ingroup sdk_database sdk_table_ops
  */
 template<typename TPK>
 bool table_delete_by_pk(const std::string& table_name, const TPK& pk_value) {
-    bsatn::Writer writer;
-    SpacetimeDB::bsatn::serialize(writer, pk_value);
-    const auto& buffer = writer.get_buffer();
-
-    ::Status status = ::table_delete_by_pk( // Calls the C ABI function from spacetimedb_abi.h
-        reinterpret_cast<const uint8_t*>(table_name.c_str()),
-        static_cast<uint32_t>(table_name.length()),
-        reinterpret_cast<const unsigned char*>(buffer.data()), // ABI expects unsigned char*
-        static_cast<uint32_t>(buffer.size())
+    const auto& tables = SpacetimeDb::ModuleSchema::instance().tables;
+    auto table_it = tables.find(table_name);
+    if (table_it == tables.end() || table_it->second.primary_key_field_name.empty()) {
+        return false;
+    }
+    std::string index_name = table_name + "_" + table_it->second.primary_key_field_name + "_idx_btree";
+    ::IndexId index_id{};
+    ::Status status = index_id_from_name(reinterpret_cast<const uint8_t*>(index_name.data()),
+                                         static_cast<uint32_t>(index_name.size()), &index_id);
+    if (status.inner != 0) {
+        return false;
+    }
+
+    EncodedIndexRange key = encode_index_eq(detail::scratch_writer(), std::forward_as_tuple(pk_value));
+    uint32_t deleted_count = 0;
+    status = datastore_delete_by_index_scan_range_bsatn(
+        index_id,
+        key.prefix_ptr(), key.prefix_len(), ::ColId{key.prefix_elems()},
+        key.start_ptr(), key.start_len(),
+        key.end_ptr(), key.end_len(),
+        &deleted_count
     );
-    return status.inner == 0; // Assumes 0 is OK
+    return status.inner == 0;
 }
 
 
@@ -0,0 +1,221 @@
+#ifndef SPACETIMEDB_SDK_INDEX_RANGE_H
+#define SPACETIMEDB_SDK_INDEX_RANGE_H
+
+#include <spacetimedb/bsatn/bsatn.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace spacetimedb {
+namespace sdk {
+
+/**
+ * @brief Kind of one end of an index range.
+ * @details The values are the variant tags of Rust's `std::ops::Bound`, which is how the host
+ *          decodes the `rstart` / `rend` arguments of `datastore_index_scan_range_bsatn`.
+ */
+enum class BoundKind : uint8_t {
+    Included = 0,
+    Excluded = 1,
+    Unbounded = 2
+};
+
+/**
+ * @brief One end of a range over an index column.
+ * @tparam T C++ type of the indexed column.
+ */
+template<typename T>
+struct Bound {
+    BoundKind kind = BoundKind::Unbounded;
+    T value{};
+
+    static Bound included(const T& v) { return Bound{BoundKind::Included, v}; }
+    static Bound excluded(const T& v) { return Bound{BoundKind::Excluded, v}; }
+    static Bound unbounded() { return Bound{}; }
+};
+
+/**
+ * @brief A range over a single index column, used after any prefix columns matched exactly.
+ * @tparam T C++ type of the indexed column.
+ */
+template<typename T>
+struct Range {
+    Bound<T> start;
+    Bound<T> end;
+
+    // Every value of the column.
+    static Range all() { return Range{}; }
+    // Exactly `v`.
+    static Range eq(const T& v) { return Range{Bound<T>::included(v), Bound<T>::included(v)}; }
+    // `lo <= x <= hi`
+    static Range closed(const T& lo, const T& hi) { return Range{Bound<T>::included(lo), Bound<T>::included(hi)}; }
+    // `lo <= x < hi`
+    static Range half_open(const T& lo, const T& hi) { return Range{Bound<T>::included(lo), Bound<T>::excluded(hi)}; }
+    // `x >= lo`
+    static Range at_least(const T& lo) { return Range{Bound<T>::included(lo), Bound<T>::unbounded()}; }
+    // `x > lo`
+    static Range greater_than(const T& lo) { return Range{Bound<T>::excluded(lo), Bound<T>::unbounded()}; }
+    // `x <= hi`
+    static Range at_most(const T& hi) { return Range{Bound<T>::unbounded(), Bound<T>::included(hi)}; }
+    // `x < hi`
+    static Range less_than(const T& hi) { return Range{Bound<T>::unbounded(), Bound<T>::excluded(hi)}; }
+};
+
+namespace detail {
+
+/**
+ * @brief Serializes `value` with whichever `SpacetimeDb::bsatn::serialize` overload matches.
+ * @details The call is unqualified on purpose: argument-dependent lookup on `Writer` then also
+ *          finds the overloads SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS generates after this header.
+ */
+template<typename V>
+void serialize_value(SpacetimeDb::bsatn::Writer& writer, const V& value) {
+    using SpacetimeDb::bsatn::serialize;
+    serialize(writer, value);
+}
+
+/**
+ * @brief Writes a single index key value as BSATN.
+ * @details Shared by every `Table<T>` method that sends column values to the host.
+ */
+template<typename V>
+void write_index_key(SpacetimeDb::bsatn::Writer& writer, const V& value) {
+    if constexpr (std::is_same_v<V, bool>) writer.write_bool(value);
+    else if constexpr (std::is_same_v<V, uint8_t>) writer.write_u8(value);
+    else if constexpr (std::is_same_v<V, uint16_t>) writer.write_u16_le(value);
+    else if constexpr (std::is_same_v<V, uint32_t>) writer.write_u32_le(value);
+    else if constexpr (std::is_same_v<V, uint64_t>) writer.write_u64_le(value);
+    else if constexpr (std::is_same_v<V, int8_t>) writer.write_i8(value);
+    else if constexpr (std::is_same_v<V, int16_t>) writer.write_i16_le(value);
+    else if constexpr (std::is_same_v<V, int32_t>) writer.write_i32_le(value);
+    else if constexpr (std::is_same_v<V, int64_t>) writer.write_i64_le(value);
+    else if constexpr (std::is_same_v<V, float>) writer.write_f32_le(value);
+    else if constexpr (std::is_same_v<V, double>) writer.write_f64_le(value);
+    else if constexpr (std::is_same_v<V, SpacetimeDb::Types::uint128_t_placeholder>) writer.write_u128_le(value);
+    else if constexpr (std::is_same_v<V, SpacetimeDb::Types::int128_t_placeholder>) writer.write_i128_le(value);
+    else if constexpr (SpacetimeDb::Types::is_wide_integer_v<V>) SpacetimeDb::bsatn::serialize(writer, value);
+    else if constexpr (std::is_same_v<V, std::string>) writer.write_string(value);
+    else if constexpr (std::is_convertible_v<const V&, std::string_view>) writer.write_string(std::string_view(value));
+    else {
+        serialize_value(writer, value);
+    }
+}
+
+// Column type a key value is encoded as: string literals and C strings are strings, as in
+// `write_index_key`, rather than the arrays or pointers they would decay to.
+template<typename V>
+using index_key_t = std::conditional_t<std::is_same_v<std::decay_t<V>, const char*> || std::is_same_v<std::decay_t<V>, char*>,
+                                       std::string_view, std::decay_t<V>>;
+
+template<typename T>
+void write_bound(SpacetimeDb::bsatn::Writer& writer, const Bound<T>& bound) {
+    writer.write_u8(static_cast<uint8_t>(bound.kind));
+    if (bound.kind != BoundKind::Unbounded) {
+        write_index_key(writer, bound.value);
+    }
+}
+
+template<typename... Prefix>
+void write_index_prefix(SpacetimeDb::bsatn::Writer& writer, const std::tuple<Prefix...>& prefix) {
+    std::apply([&writer](const auto&... elems) { (write_index_key(writer, elems), ...); }, prefix);
+}
+
+} // namespace detail
+
+/**
+ * @brief BSATN arguments for `datastore_index_scan_range_bsatn` and its delete counterpart.
+ * @details The prefix and both bounds are written into one buffer; the accessors return the
+ *          `(ptr, len)` pair for each part. The buffer is either owned, or borrowed from a
+ *          caller-supplied Writer (e.g. the `Table<T>` scratch writer), in which case the
+ *          Writer must not be written to while this object is in use.
+ */
+class EncodedIndexRange {
+public:
+    template<typename... Prefix, typename T>
+    EncodedIndexRange(const std::tuple<Prefix...>& prefix, const Range<T>& range)
+        : prefix_elems_(static_cast<uint16_t>(sizeof...(Prefix))) {
+        SpacetimeDb::bsatn::Writer writer;
+        encode(writer, prefix, range);
+        owned_ = writer.take_buffer();
+        data_ = owned_.data();
+        size_ = owned_.size();
+    }
+
+    // Encodes into `writer`, which is reset first.
+    template<typename... Prefix, typename T>
+    EncodedIndexRange(SpacetimeDb::bsatn::Writer& writer, const std::tuple<Prefix...>& prefix, const Range<T>& range)
+        : prefix_elems_(static_cast<uint16_t>(sizeof...(Prefix))) {
+        writer.reset();
+        encode(writer, prefix, range);
+        data_ = writer.data();
+        size_ = writer.size();
+    }
+
+    EncodedIndexRange(const EncodedIndexRange&) = delete;
+    EncodedIndexRange& operator=(const EncodedIndexRange&) = delete;
+    EncodedIndexRange(EncodedIndexRange&&) noexcept = default; // Moving the vector keeps `data_` valid.
+    EncodedIndexRange& operator=(EncodedIndexRange&&) noexcept = default;
+
+    const uint8_t* prefix_ptr() const { return data(); }
+    uint32_t prefix_len() const { return static_cast<uint32_t>(start_offset_); }
+    uint16_t prefix_elems() const { return prefix_elems_; }
+    const uint8_t* start_ptr() const { return data() + start_offset_; }
+    uint32_t start_len() const { return static_cast<uint32_t>(end_offset_ - start_offset_); }
+    const uint8_t* end_ptr() const { return data() + end_offset_; }
+    uint32_t end_len() const { return static_cast<uint32_t>(size_ - end_offset_); }
+
+private:
+    template<typename... Prefix, typename T>
+    void encode(SpacetimeDb::bsatn::Writer& writer, const std::tuple<Prefix...>& prefix, const Range<T>& range) {
+        detail::write_index_prefix(writer, prefix);
+        start_offset_ = writer.size();
+        detail::write_bound(writer, range.start);
+        end_offset_ = writer.size();
+        detail::write_bound(writer, range.end);
+    }
+
+    const uint8_t* data() const { return reinterpret_cast<const uint8_t*>(data_); }
+
+    std::vector<std::byte> owned_;
+    const std::byte* data_ = nullptr;
+    size_t size_ = 0;
+    size_t start_offset_ = 0;
+    size_t end_offset_ = 0;
+    uint16_t prefix_elems_ = 0;
+};
+
+/**
+ * @brief Encodes an exact match on the leading `sizeof...(Key)` columns of an index.
+ * @details The host's range ABI takes a prefix plus a range on the next column, so the last
+ *          key becomes the inclusive range `[key, key]`.
+ */
+template<typename... Key>
+EncodedIndexRange encode_index_eq(SpacetimeDb::bsatn::Writer& writer, const std::tuple<Key...>& key) {
+    static_assert(sizeof...(Key) > 0, "encode_index_eq requires at least one key column.");
+    constexpr size_t last = sizeof...(Key) - 1;
+    return [&]<size_t... I>(std::index_sequence<I...>) {
+        return EncodedIndexRange(writer, std::forward_as_tuple(std::get<I>(key)...),
+                                 Range<detail::index_key_t<std::tuple_element_t<last, std::tuple<Key...>>>>::eq(std::get<last>(key)));
+    }(std::make_index_sequence<last>{});
+}
+
+template<typename... Key>
+EncodedIndexRange encode_index_eq(const std::tuple<Key...>& key) {
+    static_assert(sizeof...(Key) > 0, "encode_index_eq requires at least one key column.");
+    constexpr size_t last = sizeof...(Key) - 1;
+    return [&]<size_t... I>(std::index_sequence<I...>) {
+        return EncodedIndexRange(std::forward_as_tuple(std::get<I>(key)...),
+                                 Range<detail::index_key_t<std::tuple_element_t<last, std::tuple<Key...>>>>::eq(std::get<last>(key)));
+    }(std::make_index_sequence<last>{});
+}
+
+} // namespace sdk
+} // namespace spacetimedb
+
+#endif // SPACETIMEDB_SDK_INDEX_RANGE_H
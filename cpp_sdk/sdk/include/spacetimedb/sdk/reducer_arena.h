@@ -0,0 +1,176 @@
+#ifndef SPACETIMEDB_SDK_REDUCER_ARENA_H
+#define SPACETIMEDB_SDK_REDUCER_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace spacetimedb {
+namespace sdk {
+
+/**
+ * @brief Bump allocator whose memory is all released at once by `reset()`.
+ * @details Allocation rounds a pointer up to the requested alignment and advances it;
+ *          deallocation does nothing. Memory comes from chunks that are kept across resets
+ *          (up to `retained_size` bytes in total), so a module that makes the same
+ *          allocations on every reducer call stops calling `malloc` after the first few.
+ *
+ *          `__call_reducer__` activates the module-wide arena (`reducer_arena()`) for the
+ *          duration of each call and resets it afterwards; see `ArenaScope`. Anything
+ *          allocated from it must not outlive the call.
+ */
+class ReducerArena final : public std::pmr::memory_resource {
+public:
+    static constexpr size_t default_chunk_size = 64 * 1024;
+    static constexpr size_t default_retained_size = 1024 * 1024;
+
+    explicit ReducerArena(size_t chunk_size = default_chunk_size, size_t retained_size = default_retained_size);
+
+    ReducerArena(const ReducerArena&) = delete;
+    ReducerArena& operator=(const ReducerArena&) = delete;
+
+    // Makes all memory handed out so far available again; frees chunks past the retained size.
+    void reset() noexcept;
+
+    // Total size of the chunks currently held.
+    size_t capacity() const noexcept;
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        uintptr_t aligned = (reinterpret_cast<uintptr_t>(cur_) + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        uintptr_t end = reinterpret_cast<uintptr_t>(end_);
+        if (aligned <= end && bytes <= end - aligned) [[likely]] {
+            cur_ = reinterpret_cast<std::byte*>(aligned + bytes);
+            return reinterpret_cast<void*>(aligned);
+        }
+        return allocate_slow(bytes, alignment);
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {} // Released by reset().
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    // Moves to the next chunk that fits, allocating one if none does.
+    void* allocate_slow(size_t bytes, size_t alignment);
+    void use_chunk(size_t index) noexcept;
+
+    std::vector<Chunk> chunks_;
+    size_t current_ = 0;
+    std::byte* cur_ = nullptr;
+    std::byte* end_ = nullptr;
+    size_t chunk_size_;
+    size_t retained_size_;
+};
+
+// The arena `__call_reducer__` activates for each call.
+ReducerArena& reducer_arena();
+
+namespace detail {
+inline std::pmr::memory_resource*& active_arena() {
+    static std::pmr::memory_resource* arena = nullptr;
+    return arena;
+}
+} // namespace detail
+
+/**
+ * @brief The memory resource for allocations that only live for the current reducer call.
+ * @details The active `ReducerArena` inside a call, `std::pmr::get_default_resource()` outside one.
+ *          Used by the SDK for its per-call buffers; user code can pass it to `std::pmr`
+ *          containers, e.g. `std::pmr::vector<Row> rows(&ctx.arena());`.
+ */
+inline std::pmr::memory_resource& current_memory_resource() {
+    std::pmr::memory_resource* arena = detail::active_arena();
+    return arena ? *arena : *std::pmr::get_default_resource();
+}
+
+/**
+ * @brief Makes `arena` the current memory resource for its lifetime, then resets it.
+ * @details Nested scopes over the same arena (a reducer invoked from within another call)
+ *          leave the reset to the outermost one.
+ */
+class ArenaScope {
+public:
+    explicit ArenaScope(ReducerArena& arena) : arena_(arena), previous_(detail::active_arena()) {
+        detail::active_arena() = &arena_;
+    }
+    ~ArenaScope() {
+        detail::active_arena() = previous_;
+        if (previous_ != &arena_) {
+            arena_.reset();
+        }
+    }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    ReducerArena& arena_;
+    std::pmr::memory_resource* previous_;
+};
+
+/**
+ * @brief Uninitialized byte buffer from a memory resource (by default the current one).
+ * @details Used for the SDK's per-call buffers (row batches, host results), so that inside a
+ *          reducer they cost a pointer bump instead of `new[]` plus `delete[]`.
+ */
+class ScratchBuffer {
+public:
+    ScratchBuffer() = default;
+    explicit ScratchBuffer(size_t size, std::pmr::memory_resource& resource = current_memory_resource())
+        : resource_(&resource),
+          data_(size ? static_cast<uint8_t*>(resource.allocate(size, alignof(std::max_align_t))) : nullptr),
+          size_(size) {}
+
+    ScratchBuffer(const ScratchBuffer&) = delete;
+    ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+    ScratchBuffer(ScratchBuffer&& other) noexcept
+        : resource_(other.resource_), data_(other.data_), size_(other.size_) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    ScratchBuffer& operator=(ScratchBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            resource_ = other.resource_;
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    ~ScratchBuffer() { release(); }
+
+    uint8_t* get() const { return data_; }
+    size_t size() const { return size_; }
+
+    // Replaces the contents with a new uninitialized buffer of `size` bytes from the current resource.
+    void reset(size_t size) { *this = ScratchBuffer(size); }
+
+private:
+    void release() noexcept {
+        if (data_) {
+            resource_->deallocate(data_, size_, alignof(std::max_align_t));
+            data_ = nullptr;
+        }
+    }
+
+    std::pmr::memory_resource* resource_ = nullptr;
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace sdk
+} // namespace spacetimedb
+
+#endif // SPACETIMEDB_SDK_REDUCER_ARENA_H
@@ -2,10 +2,17 @@
 #define REDUCER_CONTEXT_H
 
 #include <spacetimedb/sdk/spacetimedb_sdk_types.h> // For Identity, Timestamp
+#include <spacetimedb/bsatn/wide_integers.h>       // For Types::u128 (connection id)
+#include <spacetimedb/sdk/reducer_arena.h>         // For current_memory_resource
+
+#include <cstdint>
 
 namespace spacetimedb {
 namespace sdk {
 
+using ::SpacetimeDb::sdk::Identity;
+using ::SpacetimeDb::sdk::Timestamp;
+
 // Forward declaration
 class Database;
 
@@ -16,12 +23,33 @@ public:
     // and a way to interact with the database.
     ReducerContext(Identity sender, Timestamp timestamp, Database& db_instance);
 
+    // Built by __call_reducer__ from the scalars the host passes with every call, so nothing
+    // is decoded from the argument bytes and nothing is allocated. `timestamp_micros` is
+    // microseconds since the Unix epoch.
+    ReducerContext(const Identity& sender, ::SpacetimeDb::Types::u128 connection_id,
+                   uint64_t timestamp_micros, Database& db_instance) noexcept
+        : current_sender(sender),
+          current_connection_id(connection_id),
+          current_timestamp_micros(timestamp_micros),
+          database_instance(db_instance) {}
+
     // Gets the identity of the client/principal that initiated the transaction.
     const Identity& get_sender() const;
 
+    // Gets the connection the call came in on; 0 when there is none (e.g. scheduled reducers).
+    ::SpacetimeDb::Types::u128 get_connection_id() const { return current_connection_id; }
+
     // Gets the timestamp of the current transaction.
     Timestamp get_timestamp() const;
 
+    // Gets the timestamp of the current transaction at full precision.
+    uint64_t get_timestamp_micros() const { return current_timestamp_micros; }
+
+    // Memory that is released in one step when the call returns; see ReducerArena.
+    // E.g. `std::pmr::vector<uint32_t> ids(&ctx.arena());`. Nothing allocated from it may
+    // be kept past the end of the call.
+    std::pmr::memory_resource& arena() const { return current_memory_resource(); }
+
     // Provides access to database operations.
     Database& db();
     const Database& db() const; // Const overload
@@ -29,12 +57,16 @@ public:
 
 private:
     Identity current_sender;
-    Timestamp current_timestamp;
+    ::SpacetimeDb::Types::u128 current_connection_id;
+    uint64_t current_timestamp_micros;
     Database& database_instance;
     // Note: Storing a reference to Database implies Database lifetime management
     // is handled externally and outlives ReducerContext.
 };
 
+// The Database handed to reducers by __call_reducer__; lives for the whole module instance.
+Database& reducer_database();
+
 } // namespace sdk
 } // namespace spacetimedb
 
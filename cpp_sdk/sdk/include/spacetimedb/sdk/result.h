@@ -0,0 +1,113 @@
+#ifndef SPACETIMEDB_SDK_RESULT_H
+#define SPACETIMEDB_SDK_RESULT_H
+
+#include <spacetimedb/internal/exceptions.h> // For SpacetimeDb::Internal::raise
+
+#include <cstdint>
+#include <optional>
+#include <stdexcept> // For std::runtime_error
+#include <string>
+#include <utility>
+
+namespace spacetimedb {
+namespace sdk {
+
+/**
+ * @brief Why an SDK call or a reducer failed.
+ * @details `code` is the host errno (`SpacetimeDB::Abi::Errno`) when the failure came from a
+ *          host call, e.g. `UniqueAlreadyExists` from an insert, and 0 otherwise.
+ */
+struct Error {
+    std::string message;
+    uint16_t code = 0;
+};
+
+/**
+ * @brief A value of type `T`, or the `Error` that prevented producing it.
+ * @details Returned by the non-throwing SDK calls (`Table<T>::try_insert`,
+ *          `Database::try_get_table`, ...), which are the only way to see failures under
+ *          SPACETIMEDB_NO_EXCEPTIONS. The throwing calls are built on top of them.
+ *          @code
+ *          auto found = table.try_find_unique(pk_idx, id);
+ *          if (!found) return found.error();
+ *          @endcode
+ */
+template<typename T>
+class [[nodiscard]] Result {
+public:
+    Result(T value) : value_(std::move(value)) {}
+    Result(Error error) : error_(std::move(error)) {}
+
+    bool ok() const { return value_.has_value(); }
+    explicit operator bool() const { return ok(); }
+
+    // Only valid if ok().
+    T& value() & { return *value_; }
+    const T& value() const& { return *value_; }
+    T&& value() && { return std::move(*value_); }
+    T* operator->() { return &*value_; }
+    const T* operator->() const { return &*value_; }
+
+    // Only meaningful if !ok().
+    const Error& error() const { return error_; }
+
+private:
+    std::optional<T> value_;
+    Error error_;
+};
+
+template<>
+class [[nodiscard]] Result<void> {
+public:
+    Result() = default;
+    Result(Error error) : error_(std::move(error)) {}
+
+    bool ok() const { return !error_.has_value(); }
+    explicit operator bool() const { return ok(); }
+
+    // Only valid if !ok().
+    const Error& error() const { return *error_; }
+
+private:
+    std::optional<Error> error_;
+};
+
+/**
+ * @brief What a reducer may return instead of `void`.
+ * @details A failed result makes `__call_reducer__` write the message to the error sink and
+ *          report the call as failed, so the host rolls back the transaction; this is how
+ *          reducers fail under SPACETIMEDB_NO_EXCEPTIONS.
+ *          @code
+ *          ReducerResult transfer(ReducerContext& ctx, uint64_t from, uint64_t to, uint64_t amount) {
+ *              if (amount == 0) return Error{"amount must be positive"};
+ *              ...
+ *              return {};
+ *          }
+ *          @endcode
+ */
+using ReducerResult = Result<void>;
+
+namespace detail {
+
+// Unwraps `result` for the throwing SDK calls: std::runtime_error on failure, or a fatal error
+// under SPACETIMEDB_NO_EXCEPTIONS.
+template<typename T>
+T value_or_raise(Result<T>&& result) {
+    if (!result) {
+        SpacetimeDb::Internal::raise(std::runtime_error(result.error().message));
+    }
+    return std::move(result).value();
+}
+
+inline void value_or_raise(Result<void>&& result) {
+    if (!result) {
+        SpacetimeDb::Internal::raise(std::runtime_error(result.error().message));
+    }
+}
+
+} // namespace detail
+
+} // namespace sdk
+} // namespace spacetimedb
+
+#endif // SPACETIMEDB_SDK_RESULT_H
@@ -0,0 +1,283 @@
+#ifndef SPACETIMEDB_SDK_ROW_ITERATOR_H
+#define SPACETIMEDB_SDK_ROW_ITERATOR_H
+
+#include <spacetimedb/bsatn/bsatn.h>
+#include <spacetimedb/abi/spacetimedb_abi.h> // For row_iter_bsatn_advance / row_iter_bsatn_close
+#include <spacetimedb/abi/common_defs.h>     // For ::RowIter, SpacetimeDB::Abi::Errno
+#include <spacetimedb/sdk/reducer_arena.h>    // For ScratchBuffer
+#include <spacetimedb/sdk/result.h>           // For Error
+#include <spacetimedb/internal/exceptions.h>  // For SpacetimeDb::Internal::raise
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace spacetimedb {
+namespace sdk {
+
+/**
+ * @brief Initial size of the module-side buffer a `RowIterator` hands to the host.
+ * @details Matches the Rust bindings, which use twice the host's `ROW_ITER_CHUNK_SIZE` (32 KiB).
+ *          The buffer grows on demand if the host reports a single row larger than this.
+ */
+inline constexpr size_t ROW_ITER_DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+/**
+ * @brief Input range over the rows of a host `RowIter`, fetched in batches.
+ * @details Each call to `row_iter_bsatn_advance` fills one reusable buffer with as many
+ *          whole BSATN rows as fit; rows are then decoded directly out of that buffer with
+ *          `SpacetimeDb::bsatn::deserialize<T>` in ErrorMode::Status. This costs one host
+ *          call per batch instead of the two or three per row made by `TableIterator<T>`.
+ *
+ *          Usage:
+ *          @code
+ *          for (const MyRow& row : table.iter_batched()) { ... }
+ *          @endcode
+ *
+ *          Rows of types with borrowed fields (`std::string_view`, `std::span<const std::byte>`)
+ *          point into the batch buffer and are only valid until the next call to `next()`.
+ *
+ *          The host iterator is closed on destruction unless the host already reported it as
+ *          exhausted (in which case it has been destroyed host-side).
+ *
+ *          A failed host call or a malformed row ends the iteration. In ErrorMode::Throw it
+ *          then throws std::runtime_error; in ErrorMode::Status (the default under
+ *          SPACETIMEDB_NO_EXCEPTIONS, and for iterators returned by the `Table::try_*`
+ *          functions) it is only recorded, so check `ok()` afterwards:
+ *          @code
+ *          auto rows = table.iter_batched();
+ *          for (const MyRow& row : rows) { ... }
+ *          if (!rows.ok()) return rows.error();
+ *          @endcode
+ * @tparam T Row type. `SpacetimeDb::bsatn::deserialize<T>` must be available for it.
+ */
+template<typename T>
+class RowIterator {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        iterator() : owner_(nullptr) {}
+        explicit iterator(RowIterator* owner) : owner_(owner) {
+            if (owner_ && !owner_->next()) owner_ = nullptr;
+        }
+
+        reference operator*() const { return owner_->current(); }
+        pointer operator->() const { return &owner_->current(); }
+
+        iterator& operator++() {
+            if (!owner_->next()) owner_ = nullptr;
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const { return owner_ == other.owner_; }
+        bool operator!=(const iterator& other) const { return owner_ != other.owner_; }
+
+    private:
+        RowIterator* owner_;
+    };
+
+    // Error mode of a new iterator: Throw, or Status when exceptions are unavailable.
+#ifdef SPACETIMEDB_NO_EXCEPTIONS
+    static constexpr SpacetimeDb::bsatn::ErrorMode default_error_mode = SpacetimeDb::bsatn::ErrorMode::Status;
+#else
+    static constexpr SpacetimeDb::bsatn::ErrorMode default_error_mode = SpacetimeDb::bsatn::ErrorMode::Throw;
+#endif
+
+    // Default constructor yields an already-exhausted iterator.
+    RowIterator() : handle_{0} {}
+
+    /**
+     * @param projection Fields of `T` to materialize; the others are skipped and left
+     *        value-initialized (see `SpacetimeDb::bsatn::deserialize_projected`).
+     */
+    explicit RowIterator(::RowIter handle, size_t initial_buffer_size = ROW_ITER_DEFAULT_BUFFER_SIZE,
+                         SpacetimeDb::bsatn::FieldMask projection = SpacetimeDb::bsatn::FieldMask::all())
+        : handle_(handle),
+          buffer_(initial_buffer_size), // From the reducer arena inside a call; not zero-filled.
+          buffer_capacity_(initial_buffer_size),
+          projection_(projection) {}
+
+    RowIterator(const RowIterator& other) = delete;
+    RowIterator& operator=(const RowIterator& other) = delete;
+
+    RowIterator(RowIterator&& other) noexcept
+        : handle_(other.handle_),
+          buffer_(std::move(other.buffer_)),
+          buffer_capacity_(other.buffer_capacity_),
+          batch_len_(other.batch_len_),
+          batch_pos_(other.batch_pos_),
+          current_row_(std::move(other.current_row_)),
+          has_current_(other.has_current_),
+          projection_(other.projection_),
+          error_(std::move(other.error_)),
+          error_mode_(other.error_mode_) {
+        other.handle_ = ::RowIter{0};
+        other.buffer_capacity_ = 0;
+        other.batch_len_ = 0;
+        other.batch_pos_ = 0;
+        other.has_current_ = false;
+    }
+
+    RowIterator& operator=(RowIterator&& other) noexcept {
+        if (this != &other) {
+            close();
+            handle_ = other.handle_;
+            buffer_ = std::move(other.buffer_);
+            buffer_capacity_ = other.buffer_capacity_;
+            batch_len_ = other.batch_len_;
+            batch_pos_ = other.batch_pos_;
+            current_row_ = std::move(other.current_row_);
+            has_current_ = other.has_current_;
+            projection_ = other.projection_;
+            error_ = std::move(other.error_);
+            error_mode_ = other.error_mode_;
+            other.handle_ = ::RowIter{0};
+            other.buffer_capacity_ = 0;
+            other.batch_len_ = 0;
+            other.batch_pos_ = 0;
+            other.has_current_ = false;
+        }
+        return *this;
+    }
+
+    ~RowIterator() {
+        close(); // Error code ignored in destructor as exceptions shouldn't escape
+    }
+
+    iterator begin() { return iterator(this); }
+    iterator end() { return iterator(); }
+
+    /**
+     * @brief Decodes the next row, fetching a new batch from the host if the current one is used up.
+     * @return `true` if a row is available via `current()`, `false` once the host iterator is exhausted.
+     */
+    bool next() {
+        while (batch_pos_ >= batch_len_) {
+            if (!fetch_batch()) {
+                has_current_ = false;
+                return false;
+            }
+        }
+
+        const std::byte* row_start = reinterpret_cast<const std::byte*>(buffer_.get() + batch_pos_);
+        size_t available = batch_len_ - batch_pos_;
+        SpacetimeDb::bsatn::Reader reader(row_start, available, SpacetimeDb::bsatn::ErrorMode::Status);
+        if (projection_.is_all()) {
+            current_row_ = SpacetimeDb::bsatn::deserialize<T>(reader);
+        } else {
+            current_row_ = SpacetimeDb::bsatn::deserialize_projected<T>(reader, projection_);
+        }
+        if (!reader.ok()) {
+            return fail(Error{std::string("RowIterator: BSATN deserialization failed: ") +
+                              SpacetimeDb::bsatn::decode_error_message(reader.error())});
+        }
+        batch_pos_ += available - reader.remaining_bytes();
+        has_current_ = true;
+        return true;
+    }
+
+    const T& current() const {
+        if (!has_current_) {
+            SpacetimeDb::Internal::raise(std::out_of_range("Dereferencing invalid or end RowIterator"));
+        }
+        return current_row_;
+    }
+
+    // True once the host has no more rows and the current batch has been fully decoded.
+    bool is_exhausted() const { return handle_.inner == 0 && batch_pos_ >= batch_len_; }
+
+    // Sets how a failure is reported (see the class comment) and returns the previous mode.
+    SpacetimeDb::bsatn::ErrorMode set_error_mode(SpacetimeDb::bsatn::ErrorMode mode) {
+        SpacetimeDb::bsatn::ErrorMode previous = error_mode_;
+        error_mode_ = mode;
+        return previous;
+    }
+
+    // False if the iteration ended on an error rather than at the last row.
+    bool ok() const { return !error_.has_value(); }
+    // Only meaningful if !ok().
+    const Error& error() const { return *error_; }
+
+private:
+    // Refills `buffer_` from the host. Returns false if no more rows can be produced.
+    bool fetch_batch() {
+        batch_len_ = 0;
+        batch_pos_ = 0;
+        if (handle_.inner == 0) {
+            return false;
+        }
+
+        while (true) {
+            size_t len = buffer_capacity_;
+            int16_t ret = row_iter_bsatn_advance(handle_, buffer_.get(), &len);
+
+            if (ret == -1) {
+                // Exhausted: the host destroyed the iterator, but may have written a final batch.
+                handle_ = ::RowIter{0};
+                batch_len_ = len;
+                return batch_len_ > 0;
+            }
+            if (ret == 0) {
+                batch_len_ = len;
+                if (batch_len_ > 0) {
+                    return true;
+                }
+                continue; // Nothing written but not exhausted; ask again.
+            }
+            if (ret == static_cast<int16_t>(SpacetimeDB::Abi::Errno::BufferTooSmall)) {
+                // `len` now holds the size required for the next row.
+                buffer_.reset(len);
+                buffer_capacity_ = len;
+                continue;
+            }
+            return fail(Error{"RowIterator: row_iter_bsatn_advance failed with code " + std::to_string(ret),
+                              static_cast<uint16_t>(ret)});
+        }
+    }
+
+    // Ends the iteration with `error`: records it for error() and, in ErrorMode::Throw, raises it.
+    bool fail(Error error) {
+        close();
+        batch_len_ = 0;
+        batch_pos_ = 0;
+        has_current_ = false;
+        error_ = std::move(error);
+        if (error_mode_ == SpacetimeDb::bsatn::ErrorMode::Throw) {
+            SpacetimeDb::Internal::raise(std::runtime_error(error_->message));
+        }
+        return false;
+    }
+
+    void close() {
+        if (handle_.inner != 0) {
+            row_iter_bsatn_close(handle_);
+            handle_ = ::RowIter{0};
+        }
+    }
+
+    ::RowIter handle_;
+    ScratchBuffer buffer_;
+    size_t buffer_capacity_ = 0;
+    size_t batch_len_ = 0;
+    size_t batch_pos_ = 0;
+    T current_row_{};
+    bool has_current_ = false;
+    SpacetimeDb::bsatn::FieldMask projection_;
+    std::optional<Error> error_;
+    SpacetimeDb::bsatn::ErrorMode error_mode_ = default_error_mode;
+};
+
+} // namespace sdk
+} // namespace spacetimedb
+
+#endif // SPACETIMEDB_SDK_ROW_ITERATOR_H
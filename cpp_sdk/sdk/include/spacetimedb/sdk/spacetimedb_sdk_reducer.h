@@ -6,6 +6,8 @@
 #include <spacetimedb/sdk/database.h>
 #include <spacetimedb/bsatn/bsatn.h>
 #include <spacetimedb/abi/spacetimedb_abi.h>
+#include <spacetimedb/internal/table_ids.h>
+#include <spacetimedb/internal/exceptions.h> // For SPACETIMEDB_NO_EXCEPTIONS
 
 #include <string>
 #include <vector>
@@ -82,6 +84,11 @@ std::tuple<Args...> deserialize_all_args(bsatn::bsatn_reader& reader) {
     return deserialize_all_args_impl<Args...>(reader, std::index_sequence_for<Args...>{});
 }
 
+// The per-reducer export wrappers below catch exceptions, so they are not available under
+// SPACETIMEDB_NO_EXCEPTIONS; register reducers with the SPACETIMEDB_REDUCER_* macros from
+// spacetimedb/macros.h, which are dispatched by __call_reducer__.
+#ifndef SPACETIMEDB_NO_EXCEPTIONS
+
 // Macro to define and register a reducer
 #define SPACETIMEDB_REDUCER(REDUCER_FUNC_NAME, ...) \
     extern void REDUCER_FUNC_NAME(spacetimedb::sdk::ReducerContext& ctx, ##__VA_ARGS__); \
@@ -153,6 +160,8 @@ std::tuple<Args...> deserialize_all_args(bsatn::bsatn_reader& reader) {
         } \
     }
 
+#endif // SPACETIMEDB_NO_EXCEPTIONS
+
 } // namespace sdk
 } // namespace spacetimedb
 
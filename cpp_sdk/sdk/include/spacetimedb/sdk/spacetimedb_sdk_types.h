@@ -28,6 +28,8 @@ namespace SpacetimeDb {
         public:
             Identity();
             explicit Identity(const std::array<uint8_t, IDENTITY_SIZE>& bytes);
+            // From the four little-endian u64 words the host passes to __call_reducer__.
+            static Identity from_u64_words(uint64_t w0, uint64_t w1, uint64_t w2, uint64_t w3);
             // static Identity from_hex_string(const std::string& hex_str); // Implementation can be added if needed
 
             const std::array<uint8_t, IDENTITY_SIZE>& get_bytes() const;
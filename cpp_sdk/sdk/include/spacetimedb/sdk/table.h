@@ -4,11 +4,18 @@
 #include <spacetimedb/sdk/spacetimedb_sdk_types.h>
 #include <spacetimedb/bsatn/bsatn.h>
 #include <spacetimedb/abi/spacetimedb_abi.h> // For ABI function calls
+#include <spacetimedb/sdk/row_iterator.h>
+#include <spacetimedb/sdk/index_range.h>
+#include <spacetimedb/sdk/result.h>
+#include <spacetimedb/internal/exceptions.h> // For SpacetimeDb::Internal::raise
 
 #include <string>
 #include <vector>
 #include <stdexcept> // For std::runtime_error
 #include <memory>    // For std::unique_ptr in iterator if needed
+#include <tuple>
+#include <algorithm> // For std::min, std::max
+#include <optional>
 // #include <iostream>  // For temporary debugging if needed (remove for final)
 
 namespace spacetimedb {
@@ -74,21 +81,21 @@ public:
 
     const T& operator*() const {
         if (!is_valid_) {
-            throw std::out_of_range("Dereferencing invalid or end TableIterator");
+            SpacetimeDb::Internal::raise(std::out_of_range("Dereferencing invalid or end TableIterator"));
         }
         return current_row_;
     }
 
     const T* operator->() const {
         if (!is_valid_) {
-            throw std::out_of_range("Dereferencing invalid or end TableIterator");
+            SpacetimeDb::Internal::raise(std::out_of_range("Dereferencing invalid or end TableIterator"));
         }
         return &current_row_;
     }
 
     TableIterator& operator++() {
         if (!is_valid_) { // Cannot advance an invalid/end iterator
-             throw std::out_of_range("Incrementing invalid or end TableIterator");
+             SpacetimeDb::Internal::raise(std::out_of_range("Incrementing invalid or end TableIterator"));
         }
         advance();
         return *this;
@@ -114,7 +121,7 @@ private:
 
         if (error_code != 0) {
             is_valid_ = false;
-            throw std::runtime_error("TableIterator: _iter_next failed with code " + std::to_string(error_code));
+            SpacetimeDb::Internal::raise(std::runtime_error("TableIterator: _iter_next failed with code " + std::to_string(error_code)));
         }
 
         if (row_data_buffer_handle == 0) { // Standard way to signal end of iteration
@@ -123,23 +130,24 @@ private:
         }
 
         size_t len = _buffer_len(row_data_buffer_handle);
-        std::vector<uint8_t> temp_buffer(len);
+        ScratchBuffer temp_buffer(len); // From the reducer arena inside a call.
 
-        uint16_t consume_error_code = _buffer_consume(row_data_buffer_handle, temp_buffer.data(), len);
+        uint16_t consume_error_code = _buffer_consume(row_data_buffer_handle, temp_buffer.get(), len);
 
         if (consume_error_code != 0) {
             is_valid_ = false;
-            throw std::runtime_error("TableIterator: _buffer_consume failed with code " + std::to_string(consume_error_code));
+            SpacetimeDb::Internal::raise(std::runtime_error("TableIterator: _buffer_consume failed with code " + std::to_string(consume_error_code)));
         }
 
-        try {
-            bsatn::bsatn_reader reader(temp_buffer.data(), temp_buffer.size());
-            current_row_.bsatn_deserialize(reader);
-            is_valid_ = true;
-        } catch (const std::exception& e) {
+        SpacetimeDb::bsatn::Reader reader(reinterpret_cast<const std::byte*>(temp_buffer.get()), temp_buffer.size(),
+                                          SpacetimeDb::bsatn::ErrorMode::Status);
+        current_row_ = SpacetimeDb::bsatn::deserialize<T>(reader);
+        if (!reader.ok()) {
             is_valid_ = false;
-            throw std::runtime_error(std::string("TableIterator: BSATN deserialization failed: ") + e.what());
+            SpacetimeDb::Internal::raise(std::runtime_error(std::string("TableIterator: BSATN deserialization failed: ") +
+                                                            SpacetimeDb::bsatn::decode_error_message(reader.error())));
         }
+        is_valid_ = true;
     }
 
     BufferIter iter_handle_;
@@ -148,113 +156,372 @@ private:
 };
 
 
+namespace detail {
+
+// Module-wide buffer reused by single-row lookups. Modules run single-threaded, and the row is
+// fully decoded before the next lookup can overwrite it.
+inline std::vector<uint8_t>& lookup_buffer_storage() {
+    static std::vector<uint8_t> storage(1024);
+    return storage;
+}
+
+inline size_t lookup_buffer_capacity() {
+    return lookup_buffer_storage().size();
+}
+
+// Returns the buffer, grown (never shrunk) to hold at least `min_size` bytes.
+inline uint8_t* lookup_buffer(size_t min_size) {
+    std::vector<uint8_t>& storage = lookup_buffer_storage();
+    if (storage.size() < min_size) {
+        storage.resize(min_size);
+    }
+    return storage.data();
+}
+
+/**
+ * @brief Module-wide writer reused to encode rows and keys for `Table<T>` host calls.
+ * @details Returned empty but with the capacity of earlier uses, so steady-state inserts,
+ *          updates, deletes and lookups do not allocate. Each use must finish with the
+ *          encoded bytes (the host call and any write-back) before the next one starts.
+ */
+inline SpacetimeDb::bsatn::Writer& scratch_writer() {
+    static SpacetimeDb::bsatn::Writer writer = [] {
+        SpacetimeDb::bsatn::Writer w;
+        w.reserve(1024);
+        return w;
+    }();
+    writer.reset();
+    return writer;
+}
+
+} // namespace detail
+
 template<typename T>
 class Table {
 public:
     explicit Table(uint32_t table_id) : table_id_(table_id) {
-        static_assert(std::is_base_of_v<bsatn::BsatnSerializable, T> ||
-                      (requires(T& t, bsatn::bsatn_writer& w) { t.bsatn_serialize(w); } &&
-                       requires(T& t, bsatn::bsatn_reader& r) { t.bsatn_deserialize(r); }),
-                      "Table type T must implement BsatnSerializable or provide bsatn_serialize/bsatn_deserialize methods.");
+        static_assert(SpacetimeDb::bsatn::Codec<T>,
+                      "Table type T must be BSATN-serializable and deserializable.");
     }
 
+    // Every operation below that throws has a `try_` counterpart returning a `Result` instead,
+    // with the host errno in `Error::code`; these are the ones to use under
+    // SPACETIMEDB_NO_EXCEPTIONS, where the throwing ones abort on failure.
+
     void insert(T& row_data) {
-        bsatn::bsatn_writer writer;
-        row_data.bsatn_serialize(writer);
+        detail::value_or_raise(try_insert(row_data));
+    }
 
-        std::vector<uint8_t> buffer_vec = writer.move_buffer();
+    Result<void> try_insert(T& row_data) {
+        SpacetimeDb::bsatn::Writer& writer = detail::scratch_writer();
+        detail::serialize_value(writer, row_data);
 
-        uint16_t error_code = _insert(table_id_, buffer_vec.data(), buffer_vec.size());
+        uint16_t error_code = _insert(table_id_, reinterpret_cast<uint8_t*>(writer.data()), writer.size());
 
         if (error_code != 0) {
-            throw std::runtime_error("Table::insert: _insert ABI call failed with code " + std::to_string(error_code));
+            return Error{"Table::insert: _insert ABI call failed with code " + std::to_string(error_code), error_code};
+        }
+
+        auto decoded = SpacetimeDb::bsatn::try_deserialize<T>(writer.view());
+        if (!decoded) {
+            return Error{std::string("Table::insert: BSATN deserialization after insert failed: ") +
+                         SpacetimeDb::bsatn::decode_error_message(decoded.error)};
         }
+        row_data = std::move(decoded.value);
+        return {};
+    }
+
+    /**
+     * @brief Replaces the row that has the same value as `row` in a unique index, in one host call.
+     * @details Sequence (auto-increment) columns left at zero in `row` are generated by the host
+     *          and written back into `row`; set them to keep the existing values.
+     * @param unique_index_id Id of a unique index (e.g. the primary key), from `index_id()`.
+     * @throws std::runtime_error if no row matches (NO_SUCH_ROW) or the host call fails.
+     */
+    void update_by_unique(uint32_t unique_index_id, T& row) {
+        detail::value_or_raise(try_update_by_unique(unique_index_id, row));
+    }
 
-        try {
-            bsatn::bsatn_reader reader(buffer_vec.data(), buffer_vec.size());
-            row_data.bsatn_deserialize(reader);
-        } catch (const std::exception& e) {
-            throw std::runtime_error(std::string("Table::insert: BSATN deserialization after insert failed: ") + e.what());
+    Result<void> try_update_by_unique(uint32_t unique_index_id, T& row) {
+        Result<bool> updated = update_existing(unique_index_id, row, "Table::update_by_unique");
+        if (!updated) {
+            return updated.error();
         }
+        if (!updated.value()) {
+            return Error{"Table::update_by_unique: no row matches the unique index value (NO_SUCH_ROW)",
+                         static_cast<uint16_t>(SpacetimeDB::Abi::Errno::NoSuchRow)};
+        }
+        return {};
+    }
+
+    /**
+     * @brief Updates the row matching `row` in a unique index, or inserts `row` if there is none.
+     * @details Costs one host call when the row exists and two when it has to be inserted.
+     *          Generated column values are written back into `row` in both cases.
+     * @param unique_index_id Id of a unique index (e.g. the primary key), from `index_id()`.
+     */
+    void upsert(uint32_t unique_index_id, T& row) {
+        detail::value_or_raise(try_upsert(unique_index_id, row));
+    }
+
+    Result<void> try_upsert(uint32_t unique_index_id, T& row) {
+        Result<bool> updated = update_existing(unique_index_id, row, "Table::upsert");
+        if (!updated) {
+            return updated.error();
+        }
+        if (!updated.value()) {
+            return insert_bsatn(row, "Table::upsert");
+        }
+        return {};
     }
 
     template<typename ValueType>
     uint32_t delete_by_col_eq(uint32_t column_index, const ValueType& value_to_match) {
-        static_assert(
-            (std::is_arithmetic_v<ValueType> || std::is_same_v<ValueType, bool> || std::is_same_v<ValueType, std::string>) ||
-            (std::is_base_of_v<bsatn::BsatnSerializable, ValueType> || requires(const ValueType& v, bsatn::bsatn_writer& w) { v.bsatn_serialize(w); }),
-            "ValueType for delete_by_col_eq must be a supported primitive, std::string, or implement bsatn_serialize."
-        );
+        return detail::value_or_raise(try_delete_by_col_eq(column_index, value_to_match));
+    }
+
+    template<typename ValueType>
+    Result<uint32_t> try_delete_by_col_eq(uint32_t column_index, const ValueType& value_to_match) {
+        static_assert(SpacetimeDb::bsatn::Serializable<ValueType>,
+                      "ValueType for delete_by_col_eq must be BSATN-serializable.");
 
-        bsatn::bsatn_writer writer;
-        if constexpr (std::is_same_v<ValueType, bool>) writer.write_bool(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, uint8_t>) writer.write_u8(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, uint16_t>) writer.write_u16(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, uint32_t>) writer.write_u32(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, uint64_t>) writer.write_u64(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, int8_t>) writer.write_i8(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, int16_t>) writer.write_i16(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, int32_t>) writer.write_i32(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, int64_t>) writer.write_i64(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, float>) writer.write_f32(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, double>) writer.write_f64(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, std::string>) writer.write_string(value_to_match);
-        else {
-            value_to_match.bsatn_serialize(writer);
-        }
-
-        std::vector<uint8_t> value_buffer_vec = writer.move_buffer();
+        SpacetimeDb::bsatn::Writer& writer = detail::scratch_writer();
+        detail::write_index_key(writer, value_to_match);
         uint32_t deleted_count = 0;
 
-        uint16_t error_code = _delete_by_col_eq(table_id_, column_index, value_buffer_vec.data(), value_buffer_vec.size(), &deleted_count);
+        uint16_t error_code = _delete_by_col_eq(table_id_, column_index, reinterpret_cast<const uint8_t*>(writer.data()),
+                                                writer.size(), &deleted_count);
 
         if (error_code != 0) {
-            throw std::runtime_error("Table::delete_by_col_eq: _delete_by_col_eq ABI call failed with code " + std::to_string(error_code));
+            return Error{"Table::delete_by_col_eq: _delete_by_col_eq ABI call failed with code " + std::to_string(error_code), error_code};
         }
         return deleted_count;
     }
 
+    // Row-at-a-time iteration. Its per-row host call failures are fatal under
+    // SPACETIMEDB_NO_EXCEPTIONS; prefer `iter_batched()`, which reports them through `ok()`.
     TableIterator<T> iter() {
+        return detail::value_or_raise(try_iter());
+    }
+
+    Result<TableIterator<T>> try_iter() {
         BufferIter iter_handle = 0;
         uint16_t error_code = _iter_start(table_id_, &iter_handle);
         if (error_code != 0) {
-            throw std::runtime_error("Table::iter: _iter_start ABI call failed with code " + std::to_string(error_code));
+            return Error{"Table::iter: _iter_start ABI call failed with code " + std::to_string(error_code), error_code};
         }
         return TableIterator<T>(iter_handle);
     }
 
+    /**
+     * @brief Number of rows currently in the table, without scanning it.
+     * @details A single `datastore_table_row_count` host call.
+     */
+    uint64_t count() const {
+        return detail::value_or_raise(try_count());
+    }
+
+    Result<uint64_t> try_count() const {
+        uint64_t row_count = 0;
+        ::Status status = datastore_table_row_count(::TableId{table_id_}, &row_count);
+        if (status.inner != 0) {
+            return Error{"Table::count: datastore_table_row_count ABI call failed with code " + std::to_string(status.inner), status.inner};
+        }
+        return row_count;
+    }
+
+    /**
+     * @brief Reads the whole table into a vector sized up front from `count()`.
+     */
+    std::vector<T> collect() {
+        return detail::value_or_raise(try_collect());
+    }
+
+    Result<std::vector<T>> try_collect() {
+        Result<uint64_t> row_count = try_count();
+        if (!row_count) {
+            return row_count.error();
+        }
+        Result<RowIterator<T>> scan = try_iter_batched();
+        if (!scan) {
+            return scan.error();
+        }
+        std::vector<T> rows;
+        rows.reserve(static_cast<size_t>(row_count.value()));
+        for (const T& row : scan.value()) {
+            rows.push_back(row);
+        }
+        if (!scan->ok()) {
+            return scan->error();
+        }
+        return rows;
+    }
+
+    /**
+     * @brief Full table scan that fetches rows from the host in batches.
+     * @details Prefer this over `iter()` for large tables: it makes one `row_iter_bsatn_advance`
+     *          call per batch of rows rather than several host calls per row.
+     * @param buffer_size Initial size of the reusable row buffer handed to the host.
+     */
+    RowIterator<T> iter_batched(size_t buffer_size = ROW_ITER_DEFAULT_BUFFER_SIZE) {
+        return iter_batched(SpacetimeDb::bsatn::FieldMask::all(), buffer_size);
+    }
+
+    /**
+     * @brief Full table scan that only materializes the fields in `projection`.
+     * @details The other fields are skipped without being decoded (no strings or vectors are
+     *          built for them) and are value-initialized in the yielded rows, e.g.
+     *          `table.iter_batched(SpacetimeDb::bsatn::field_mask<Player>({"id", "x"}))`.
+     */
+    RowIterator<T> iter_batched(SpacetimeDb::bsatn::FieldMask projection, size_t buffer_size = ROW_ITER_DEFAULT_BUFFER_SIZE) {
+        return raising(try_iter_batched(projection, buffer_size));
+    }
+
+    Result<RowIterator<T>> try_iter_batched(size_t buffer_size = ROW_ITER_DEFAULT_BUFFER_SIZE) {
+        return try_iter_batched(SpacetimeDb::bsatn::FieldMask::all(), buffer_size);
+    }
+
+    Result<RowIterator<T>> try_iter_batched(SpacetimeDb::bsatn::FieldMask projection, size_t buffer_size = ROW_ITER_DEFAULT_BUFFER_SIZE) {
+        ::RowIter iter_handle{0};
+        ::Status status = datastore_table_scan_bsatn(::TableId{table_id_}, &iter_handle);
+        if (status.inner != 0) {
+            return Error{"Table::iter_batched: datastore_table_scan_bsatn ABI call failed with code " + std::to_string(status.inner), status.inner};
+        }
+        return reporting(RowIterator<T>(iter_handle, buffer_size, projection));
+    }
+
+    /**
+     * @brief Resolves an index name (as registered with the host) to its id.
+     * @details Index ids are stable for the lifetime of the module; callers scanning the same index
+     *          repeatedly should resolve it once and reuse the id.
+     */
+    uint32_t index_id(const std::string& index_name) const {
+        return detail::value_or_raise(try_index_id(index_name));
+    }
+
+    Result<uint32_t> try_index_id(const std::string& index_name) const {
+        ::IndexId id{0};
+        ::Status status = index_id_from_name(
+            reinterpret_cast<const uint8_t*>(index_name.data()),
+            static_cast<uint32_t>(index_name.length()),
+            &id
+        );
+        if (status.inner != 0) {
+            return Error{"Table::index_id: index_id_from_name ABI call failed for index '" +
+                         index_name + "' with code " + std::to_string(status.inner), status.inner};
+        }
+        return id.inner;
+    }
+
+    /**
+     * @brief Scans a B-tree index: exact match on the leading columns, then a range on the next one.
+     * @details Rows are fetched in batches and decoded lazily, as with `iter_batched()`.
+     *          @code
+     *          // Index on (x, z, dimension): x == 0 and 10 <= z < 20.
+     *          for (const Location& loc : table.scan_range(coords_idx, std::make_tuple(0), Range<int32_t>::half_open(10, 20))) { ... }
+     *          @endcode
+     * @param index_id Id from `index_id()`.
+     * @param prefix Values for the leading index columns, in index column order. May be empty.
+     * @param range Bounds on the column following the prefix.
+     */
+    template<typename... Prefix, typename Col>
+    RowIterator<T> scan_range(uint32_t index_id, const std::tuple<Prefix...>& prefix, const Range<Col>& range,
+                              size_t buffer_size = ROW_ITER_DEFAULT_BUFFER_SIZE) {
+        return raising(try_scan_range(index_id, prefix, range, buffer_size));
+    }
+
+    template<typename Col>
+    RowIterator<T> scan_range(uint32_t index_id, const Range<Col>& range,
+                              size_t buffer_size = ROW_ITER_DEFAULT_BUFFER_SIZE) {
+        return scan_range(index_id, std::tuple<>{}, range, buffer_size);
+    }
+
+    template<typename... Prefix, typename Col>
+    Result<RowIterator<T>> try_scan_range(uint32_t index_id, const std::tuple<Prefix...>& prefix, const Range<Col>& range,
+                                          size_t buffer_size = ROW_ITER_DEFAULT_BUFFER_SIZE) {
+        return scan_encoded(index_id, EncodedIndexRange(detail::scratch_writer(), prefix, range), buffer_size, "Table::scan_range");
+    }
+
+    template<typename Col>
+    Result<RowIterator<T>> try_scan_range(uint32_t index_id, const Range<Col>& range,
+                                          size_t buffer_size = ROW_ITER_DEFAULT_BUFFER_SIZE) {
+        return try_scan_range(index_id, std::tuple<>{}, range, buffer_size);
+    }
+
+    /**
+     * @brief Scans an index for rows whose leading columns equal `key...`.
+     * @details Equivalent to a Rust `index.filter((a, b))`; may name fewer columns than the index has.
+     */
+    template<typename... Key>
+    RowIterator<T> scan_prefix(uint32_t index_id, const Key&... key) {
+        return raising(try_scan_prefix(index_id, key...));
+    }
+
+    template<typename... Key>
+    Result<RowIterator<T>> try_scan_prefix(uint32_t index_id, const Key&... key) {
+        return scan_encoded(index_id, encode_index_eq(detail::scratch_writer(), std::forward_as_tuple(key...)),
+                            ROW_ITER_DEFAULT_BUFFER_SIZE, "Table::scan_prefix");
+    }
+
+    /**
+     * @brief Deletes all rows in an index range with a single host call.
+     * @details Takes the same prefix/range arguments as `scan_range()`; no rows are read back
+     *          into the module.
+     * @return Number of rows deleted.
+     */
+    template<typename... Prefix, typename Col>
+    uint32_t delete_range(uint32_t index_id, const std::tuple<Prefix...>& prefix, const Range<Col>& range) {
+        return detail::value_or_raise(try_delete_range(index_id, prefix, range));
+    }
+
+    template<typename Col>
+    uint32_t delete_range(uint32_t index_id, const Range<Col>& range) {
+        return delete_range(index_id, std::tuple<>{}, range);
+    }
+
+    template<typename... Prefix, typename Col>
+    Result<uint32_t> try_delete_range(uint32_t index_id, const std::tuple<Prefix...>& prefix, const Range<Col>& range) {
+        return delete_encoded(index_id, EncodedIndexRange(detail::scratch_writer(), prefix, range), "Table::delete_range");
+    }
+
+    template<typename Col>
+    Result<uint32_t> try_delete_range(uint32_t index_id, const Range<Col>& range) {
+        return try_delete_range(index_id, std::tuple<>{}, range);
+    }
+
+    /**
+     * @brief Deletes all rows whose leading index columns equal `key...`.
+     * @return Number of rows deleted.
+     */
+    template<typename... Key>
+    uint32_t delete_by_prefix(uint32_t index_id, const Key&... key) {
+        return detail::value_or_raise(try_delete_by_prefix(index_id, key...));
+    }
+
+    template<typename... Key>
+    Result<uint32_t> try_delete_by_prefix(uint32_t index_id, const Key&... key) {
+        return delete_encoded(index_id, encode_index_eq(detail::scratch_writer(), std::forward_as_tuple(key...)), "Table::delete_by_prefix");
+    }
+
     template<typename ValueType>
     std::vector<T> find_by_col_eq(uint32_t column_index, const ValueType& value_to_match) {
-         static_assert(
-            (std::is_arithmetic_v<ValueType> || std::is_same_v<ValueType, bool> || std::is_same_v<ValueType, std::string>) ||
-            (std::is_base_of_v<bsatn::BsatnSerializable, ValueType> || requires(const ValueType& v, bsatn::bsatn_writer& w) { v.bsatn_serialize(w); }),
-            "ValueType for find_by_col_eq must be a supported primitive, std::string, or implement bsatn_serialize."
-        );
+        return detail::value_or_raise(try_find_by_col_eq(column_index, value_to_match));
+    }
 
-        bsatn::bsatn_writer writer;
-        if constexpr (std::is_same_v<ValueType, bool>) writer.write_bool(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, uint8_t>) writer.write_u8(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, uint16_t>) writer.write_u16(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, uint32_t>) writer.write_u32(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, uint64_t>) writer.write_u64(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, int8_t>) writer.write_i8(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, int16_t>) writer.write_i16(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, int32_t>) writer.write_i32(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, int64_t>) writer.write_i64(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, float>) writer.write_f32(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, double>) writer.write_f64(value_to_match);
-        else if constexpr (std::is_same_v<ValueType, std::string>) writer.write_string(value_to_match);
-        else {
-            value_to_match.bsatn_serialize(writer);
-        }
-
-        std::vector<uint8_t> value_buffer_vec = writer.move_buffer();
+    template<typename ValueType>
+    Result<std::vector<T>> try_find_by_col_eq(uint32_t column_index, const ValueType& value_to_match) {
+         static_assert(SpacetimeDb::bsatn::Serializable<ValueType>,
+                      "ValueType for find_by_col_eq must be BSATN-serializable.");
+
+        SpacetimeDb::bsatn::Writer& writer = detail::scratch_writer();
+        detail::write_index_key(writer, value_to_match);
         Buffer result_buffer_handle = 0;
 
-        uint16_t error_code = _iter_by_col_eq(table_id_, column_index, value_buffer_vec.data(), value_buffer_vec.size(), &result_buffer_handle);
+        uint16_t error_code = _iter_by_col_eq(table_id_, column_index, reinterpret_cast<const uint8_t*>(writer.data()),
+                                              writer.size(), &result_buffer_handle);
 
         if (error_code != 0) {
-            throw std::runtime_error("Table::find_by_col_eq: _iter_by_col_eq ABI call failed with code " + std::to_string(error_code));
+            return Error{"Table::find_by_col_eq: _iter_by_col_eq ABI call failed with code " + std::to_string(error_code), error_code};
         }
 
         std::vector<T> results;
@@ -263,30 +530,223 @@ public:
         }
 
         size_t len = _buffer_len(result_buffer_handle);
-        std::vector<uint8_t> concatenated_rows_buffer(len);
+        ScratchBuffer concatenated_rows_buffer(len); // From the reducer arena inside a call.
 
-        uint16_t consume_error_code = _buffer_consume(result_buffer_handle, concatenated_rows_buffer.data(), len);
+        uint16_t consume_error_code = _buffer_consume(result_buffer_handle, concatenated_rows_buffer.get(), len);
 
         if (consume_error_code != 0) {
-            throw std::runtime_error("Table::find_by_col_eq: _buffer_consume failed with code " + std::to_string(consume_error_code));
+            return Error{"Table::find_by_col_eq: _buffer_consume failed with code " + std::to_string(consume_error_code), consume_error_code};
         }
 
         if (len > 0) {
-            bsatn::bsatn_reader reader(concatenated_rows_buffer.data(), concatenated_rows_buffer.size());
-            try {
-                while(!reader.eof()) {
-                    T row_data;
-                    row_data.bsatn_deserialize(reader);
-                    results.push_back(std::move(row_data));
-                }
-            } catch (const std::exception& e) {
-                throw std::runtime_error(std::string("Table::find_by_col_eq: BSATN deserialization of concatenated rows failed: ") + e.what());
+            SpacetimeDb::bsatn::Reader reader(reinterpret_cast<const std::byte*>(concatenated_rows_buffer.get()), len,
+                                              SpacetimeDb::bsatn::ErrorMode::Status);
+            results.push_back(SpacetimeDb::bsatn::deserialize<T>(reader));
+            if (reader.ok() && !reader.is_eos()) {
+                // Estimate the row count from the first row's size. The buffer holds every match,
+                // so the estimate is bounded by `len` and costs no host call.
+                size_t first_row_len = len - reader.remaining_bytes();
+                results.reserve(1 + reader.remaining_bytes() / std::max<size_t>(first_row_len, 1));
+            }
+            while (reader.ok() && !reader.is_eos()) {
+                results.push_back(SpacetimeDb::bsatn::deserialize<T>(reader));
+            }
+            if (!reader.ok()) {
+                return Error{std::string("Table::find_by_col_eq: BSATN deserialization of concatenated rows failed: ") +
+                             SpacetimeDb::bsatn::decode_error_message(reader.error())};
             }
         }
         return results;
     }
 
+    /**
+     * @brief Looks up the single row whose column `Col` equals `key`.
+     * @details Intended for primary-key and unique columns. The host buffer is read into a reusable
+     *          module-wide buffer and at most one row is decoded from it; no result vector is built.
+     * @tparam Col Column position of the unique column in the row.
+     * @return The row, or `std::nullopt` if there is none.
+     */
+    template<uint32_t Col, typename Key>
+    std::optional<T> find_unique(const Key& key) {
+        return detail::value_or_raise(try_find_unique<Col>(key));
+    }
+
+    template<uint32_t Col, typename Key>
+    Result<std::optional<T>> try_find_unique(const Key& key) {
+        SpacetimeDb::bsatn::Writer& writer = detail::scratch_writer();
+        detail::write_index_key(writer, key);
+
+        Buffer result_buffer_handle = 0;
+        uint16_t error_code = _iter_by_col_eq(table_id_, Col, reinterpret_cast<const uint8_t*>(writer.data()),
+                                              writer.size(), &result_buffer_handle);
+        if (error_code != 0) {
+            return Error{"Table::find_unique: _iter_by_col_eq ABI call failed with code " + std::to_string(error_code), error_code};
+        }
+        if (result_buffer_handle == 0) {
+            return std::optional<T>();
+        }
+
+        size_t len = _buffer_len(result_buffer_handle);
+        uint8_t* data = detail::lookup_buffer(len);
+        uint16_t consume_error_code = _buffer_consume(result_buffer_handle, data, len);
+        if (consume_error_code != 0) {
+            return Error{"Table::find_unique: _buffer_consume failed with code " + std::to_string(consume_error_code), consume_error_code};
+        }
+        return decode_first_row(data, len, "Table::find_unique");
+    }
+
+    /**
+     * @brief Looks up the single row whose leading columns in a unique index equal `key...`.
+     * @details Reads one batch from `datastore_index_scan_range_bsatn` into the same reusable buffer
+     *          as the column variant and decodes at most one row from it.
+     * @param unique_index_id Id of a unique index (e.g. the primary key), from `index_id()`.
+     */
+    template<typename... Key>
+    std::optional<T> find_unique(uint32_t unique_index_id, const Key&... key) {
+        return detail::value_or_raise(try_find_unique(unique_index_id, key...));
+    }
+
+    template<typename... Key>
+    Result<std::optional<T>> try_find_unique(uint32_t unique_index_id, const Key&... key) {
+        EncodedIndexRange encoded = encode_index_eq(detail::scratch_writer(), std::forward_as_tuple(key...));
+        ::RowIter iter_handle{0};
+        ::Status status = datastore_index_scan_range_bsatn(
+            ::IndexId{unique_index_id},
+            encoded.prefix_ptr(), encoded.prefix_len(), ::ColId{encoded.prefix_elems()},
+            encoded.start_ptr(), encoded.start_len(),
+            encoded.end_ptr(), encoded.end_len(),
+            &iter_handle
+        );
+        if (status.inner != 0) {
+            return Error{"Table::find_unique: datastore_index_scan_range_bsatn ABI call failed with code " + std::to_string(status.inner), status.inner};
+        }
+
+        size_t capacity = detail::lookup_buffer_capacity();
+        while (true) {
+            size_t len = capacity;
+            uint8_t* data = detail::lookup_buffer(capacity);
+            int16_t ret = row_iter_bsatn_advance(iter_handle, data, &len);
+            if (ret == static_cast<int16_t>(SpacetimeDB::Abi::Errno::BufferTooSmall)) {
+                capacity = len;
+                continue;
+            }
+            if (ret == 0) {
+                if (len == 0) {
+                    continue; // Nothing written but not exhausted; ask again, as RowIterator does.
+                }
+                row_iter_bsatn_close(iter_handle); // A unique match has no further rows to read.
+            } else if (ret != -1) {
+                row_iter_bsatn_close(iter_handle);
+                return Error{"Table::find_unique: row_iter_bsatn_advance failed with code " + std::to_string(ret),
+                             static_cast<uint16_t>(ret)};
+            }
+            return decode_first_row(data, len, "Table::find_unique");
+        }
+    }
+
 private:
+    // Returns false if the host reports NO_SUCH_ROW, an error on any other failure.
+    Result<bool> update_existing(uint32_t index_id, T& row, const char* caller) {
+        SpacetimeDb::bsatn::Writer& writer = detail::scratch_writer();
+        detail::serialize_value(writer, row);
+        size_t len = writer.size();
+
+        ::Status status = datastore_update_bsatn(::TableId{table_id_}, ::IndexId{index_id},
+                                                 reinterpret_cast<uint8_t*>(writer.data()), &len);
+        if (SpacetimeDB::Abi::is_errno(status, SpacetimeDB::Abi::Errno::NoSuchRow)) {
+            return false;
+        }
+        if (status.inner != 0) {
+            return Error{std::string(caller) + ": datastore_update_bsatn ABI call failed with code " + std::to_string(status.inner), status.inner};
+        }
+        Result<void> written_back = read_generated_columns(writer.data(), len, row, caller);
+        if (!written_back) {
+            return written_back.error();
+        }
+        return true;
+    }
+
+    Result<void> insert_bsatn(T& row, const char* caller) {
+        SpacetimeDb::bsatn::Writer& writer = detail::scratch_writer();
+        detail::serialize_value(writer, row);
+        size_t len = writer.size();
+
+        ::Status status = datastore_insert_bsatn(::TableId{table_id_}, reinterpret_cast<uint8_t*>(writer.data()), &len);
+        if (status.inner != 0) {
+            return Error{std::string(caller) + ": datastore_insert_bsatn ABI call failed with code " + std::to_string(status.inner), status.inner};
+        }
+        return read_generated_columns(writer.data(), len, row, caller);
+    }
+
+    static Result<std::optional<T>> decode_first_row(const uint8_t* data, size_t len, const char* caller) {
+        if (len == 0) {
+            return std::optional<T>();
+        }
+        auto decoded = SpacetimeDb::bsatn::try_deserialize<T>(
+            std::span<const std::byte>(reinterpret_cast<const std::byte*>(data), len));
+        if (!decoded) {
+            return Error{std::string(caller) + ": BSATN deserialization failed: " +
+                         SpacetimeDb::bsatn::decode_error_message(decoded.error)};
+        }
+        return std::optional<T>(std::move(decoded.value));
+    }
+
+    static Result<void> read_generated_columns(const std::byte* data, size_t len, T& row, const char* caller) {
+        if (len == 0) {
+            return {}; // Table has no sequence columns.
+        }
+        SpacetimeDb::bsatn::Reader reader(data, len, SpacetimeDb::bsatn::ErrorMode::Status);
+        SpacetimeDb::bsatn::apply_generated_columns(reader, row);
+        if (!reader.ok()) {
+            return Error{std::string(caller) + ": BSATN deserialization of generated columns failed: " +
+                         SpacetimeDb::bsatn::decode_error_message(reader.error())};
+        }
+        return {};
+    }
+
+    Result<RowIterator<T>> scan_encoded(uint32_t index_id, const EncodedIndexRange& encoded, size_t buffer_size, const char* caller) {
+        ::RowIter iter_handle{0};
+        ::Status status = datastore_index_scan_range_bsatn(
+            ::IndexId{index_id},
+            encoded.prefix_ptr(), encoded.prefix_len(), ::ColId{encoded.prefix_elems()},
+            encoded.start_ptr(), encoded.start_len(),
+            encoded.end_ptr(), encoded.end_len(),
+            &iter_handle
+        );
+        if (status.inner != 0) {
+            return Error{std::string(caller) + ": datastore_index_scan_range_bsatn ABI call failed with code " + std::to_string(status.inner), status.inner};
+        }
+        return reporting(RowIterator<T>(iter_handle, buffer_size));
+    }
+
+    // Iterators returned by the `try_*` scans report iteration errors through `RowIterator::ok()`.
+    static RowIterator<T> reporting(RowIterator<T> rows) {
+        rows.set_error_mode(SpacetimeDb::bsatn::ErrorMode::Status);
+        return rows;
+    }
+
+    // Iterators returned by the throwing scans raise them, unless exceptions are unavailable.
+    static RowIterator<T> raising(Result<RowIterator<T>>&& result) {
+        RowIterator<T> rows = detail::value_or_raise(std::move(result));
+        rows.set_error_mode(RowIterator<T>::default_error_mode);
+        return rows;
+    }
+
+    Result<uint32_t> delete_encoded(uint32_t index_id, const EncodedIndexRange& encoded, const char* caller) {
+        uint32_t deleted_count = 0;
+        ::Status status = datastore_delete_by_index_scan_range_bsatn(
+            ::IndexId{index_id},
+            encoded.prefix_ptr(), encoded.prefix_len(), ::ColId{encoded.prefix_elems()},
+            encoded.start_ptr(), encoded.start_len(),
+            encoded.end_ptr(), encoded.end_len(),
+            &deleted_count
+        );
+        if (status.inner != 0) {
+            return Error{std::string(caller) + ": datastore_delete_by_index_scan_range_bsatn ABI call failed with code " + std::to_string(status.inner), status.inner};
+        }
+        return deleted_count;
+    }
+
     uint32_t table_id_;
 };
 
@@ -1,9 +1,12 @@
 #include "spacetimedb/abi/spacetime_module_exports.h"
 #include "spacetimedb/abi/abi_utils.h"
 #include "spacetimedb/internal/module_def.h"  // Updated path
+#include "spacetimedb/bsatn/sink_writer.h"     // For bsatn::SinkWriter
+#include "spacetimedb/internal/exceptions.h"   // For SPACETIMEDB_NO_EXCEPTIONS
 
 #include <vector>
 #include <cstddef> // For std::byte
+#include <span>    // For std::span
 #include <string>  // For std::string in error handling
 #include <iostream> // For temporary error logging if needed
 
@@ -12,34 +15,43 @@
 extern "C" {
 
     void __describe_module__(BytesSink description_sink_handle) {
+        // Sink failures are recorded rather than thrown, so they are reported the same way with
+        // or without exceptions; the chunks after a failed one are dropped.
+        uint16_t sink_status = 0;
+        auto write_description = [&] {
+            // Serialize the ModuleDef straight into the sink a few KB at a time, so memory use
+            // does not grow with the size of the schema.
+            SpacetimeDb::bsatn::SinkWriter writer([description_sink_handle, &sink_status](std::span<const std::byte> bytes) {
+                if (sink_status == 0) {
+                    sink_status = SpacetimeDB::Abi::Utils::try_write_bytes_to_sink(description_sink_handle,
+                        reinterpret_cast<const unsigned char*>(bytes.data()), static_cast<uint32_t>(bytes.size())).inner;
+                }
+            });
+            SpacetimeDb::Internal::write_module_definition(writer);
+            writer.flush();
+        };
+
+#ifdef SPACETIMEDB_NO_EXCEPTIONS
+        // An invalid schema is a fatal error here; the module cannot load without its description.
+        write_description();
+#else
         try {
-            // 1. Get the serialized ModuleDef
-            std::vector<std::byte> module_def_bytes = SpacetimeDb::Internal::get_serialized_module_definition_bytes();
-
-            // 2. Write it to the sink
-            SpacetimeDB::Abi::Utils::write_vector_to_sink(description_sink_handle, module_def_bytes);
-
+            write_description();
         }
         catch (const std::exception& e) {
             std::cerr << "Critical Error in __describe_module__: " << e.what() << std::endl;
-            try {
-                std::string error_msg = "Error generating module description: " + std::string(e.what());
-                // Assuming write_string_to_sink is robust enough or we accept potential nested exception here.
-                SpacetimeDB::Abi::Utils::write_string_to_sink(description_sink_handle, error_msg);
-            }
-            catch (const std::exception& sink_e) {
-                std::cerr << "Additionally, failed to write error to sink in __describe_module__: " << sink_e.what() << std::endl;
-            }
+            std::string error_msg = "Error generating module description: " + std::string(e.what());
+            SpacetimeDB::Abi::Utils::try_write_string_to_sink(description_sink_handle, error_msg);
+            return;
         }
         catch (...) {
             std::cerr << "Critical Unknown Error in __describe_module__." << std::endl;
-            try {
-                std::string error_msg = "Unknown error generating module description.";
-                SpacetimeDB::Abi::Utils::write_string_to_sink(description_sink_handle, error_msg);
-            }
-            catch (...) {
-                // Silent failure to write to sink if error reporting itself fails
-            }
+            SpacetimeDB::Abi::Utils::try_write_string_to_sink(description_sink_handle, "Unknown error generating module description.");
+            return;
+        }
+#endif
+        if (sink_status != 0) {
+            std::cerr << "Critical Error in __describe_module__: host failed to write to BytesSink, status: " << sink_status << std::endl;
         }
     }
 
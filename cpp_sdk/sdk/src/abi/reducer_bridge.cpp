@@ -2,45 +2,36 @@
 #include "spacetimedb/abi/abi_utils.h"           // For SpacetimeDB::Abi::Utils helpers
 #include "spacetimedb/internal/module_schema.h"  // Updated path, For SpacetimeDb::ModuleSchema
 #include "spacetimedb/bsatn/reader.h"            // For bsatn::Reader
+#include "spacetimedb/bsatn/streaming_reader.h"  // For bsatn::StreamingReader (large argument payloads)
 #include "spacetimedb/bsatn/writer.h"            // For bsatn::Writer (to serialize errors)
+#include "spacetimedb/sdk/reducer_context.h"     // For spacetimedb::sdk::ReducerContext
+#include "spacetimedb/sdk/reducer_arena.h"       // For spacetimedb::sdk::ArenaScope
+#include "spacetimedb/sdk/result.h"              // For spacetimedb::sdk::ReducerResult
+#include "spacetimedb/internal/exceptions.h"     // For SPACETIMEDB_NO_EXCEPTIONS
 
 #include <string>
 #include <vector>
 #include <stdexcept> // For std::runtime_error
 #include <iostream>  // For temporary error logging
-#include <algorithm> // For std::advance (iterator increment)
 #include <cstddef>   // For std::byte
-
-// Note: SPACETIMEDB_WASM_EXPORT is applied in the header "spacetime_module_exports.h"
-
-extern "C" {
-
-    // Helper to get the Nth reducer definition from the schema's map.
-    // THIS IS A TEMPORARY AND INEFFICIENT APPROACH for mapping reducer_id.
-    // A proper solution would involve registering reducers with stable numeric IDs.
-    const SpacetimeDb::ReducerDefinition* get_reducer_by_id(const SpacetimeDb::ModuleSchema& schema, uint32_t reducer_id) {
-        if (reducer_id >= schema.reducers.size()) {
-            std::cerr << "Error: reducer_id " << reducer_id << " is out of bounds. Total reducers: " << schema.reducers.size() << std::endl;
-            return nullptr;
+#include <span>      // For std::span
+
+namespace {
+    // Argument payloads above this size are decoded with a StreamingReader instead of being
+    // copied into one vector first.
+    constexpr uint32_t streaming_args_threshold = 64 * 1024;
+
+    // Logs an error and writes it to the error sink. A failing sink write is only logged, so
+    // that reporting one error never raises another.
+    void report_error(BytesSink error_sink_handle, const std::string& error_msg) {
+        std::cerr << "Error in __call_reducer__: " << error_msg << std::endl;
+        ::Status status = SpacetimeDB::Abi::Utils::try_write_string_to_sink(error_sink_handle, error_msg);
+        if (status.inner != 0) {
+            std::cerr << "Additionally, failed to write error to sink in __call_reducer__, status: " << status.inner << std::endl;
         }
-        auto it = schema.reducers.begin();
-        // std::advance is O(N), direct indexing would be better if reducers were in a vector or map<id, def>
-        for (uint32_t i = 0; i < reducer_id; ++i) {
-            if (it == schema.reducers.end()) { // Should not happen if size check is correct
-                std::cerr << "Error: Advanced past end of reducers map unexpectedly for reducer_id " << reducer_id << std::endl;
-                return nullptr;
-            }
-            ++it;
-        }
-        if (it == schema.reducers.end() && reducer_id < schema.reducers.size()) { // Should not happen
-            std::cerr << "Error: Iterator is end but reducer_id " << reducer_id << " should be valid." << std::endl;
-            return nullptr;
-        }
-        return &(it->second);
     }
 
-
-    int16_t __call_reducer__(
+    int16_t call_reducer(
         uint32_t reducer_id,
         uint64_t sender_identity_p0,
         uint64_t sender_identity_p1,
@@ -52,43 +43,53 @@ extern "C" {
         BytesSource args_source_handle,
         BytesSink error_sink_handle
     ) {
-        (void)sender_identity_p0; (void)sender_identity_p1; (void)sender_identity_p2; (void)sender_identity_p3;
-        (void)connection_id_p0; (void)connection_id_p1;
-        (void)timestamp;
+        // Per-call allocations (arguments, row batches, ctx.arena() containers) come from
+        // the reducer arena, released in one step when the call returns.
+        spacetimedb::sdk::ArenaScope arena_scope(spacetimedb::sdk::reducer_arena());
 
-        // args_source_handle and error_sink_handle are externally managed.
-        // We don't use ManagedBytesSource/Sink for them here as they don't take existing handles.
+        const SpacetimeDb::ReducerDispatchEntry* entry =
+            SpacetimeDb::ModuleSchema::instance().reducer_by_id(reducer_id);
 
-        try {
-            std::vector<std::byte> args_bytes = SpacetimeDB::Abi::Utils::read_all_from_source(args_source_handle);
-            SpacetimeDb::bsatn::Reader reader(args_bytes);
-            const auto& schema = SpacetimeDb::ModuleSchema::instance();
-            const SpacetimeDb::ReducerDefinition* reducer_def_ptr = get_reducer_by_id(schema, reducer_id);
-
-            if (!reducer_def_ptr) {
-                std::string error_msg = "Reducer with ID " + std::to_string(reducer_id) + " not found.";
-                std::cerr << "Error in __call_reducer__: " << error_msg << std::endl;
-                // Use error_sink_handle directly
-                SpacetimeDB::Abi::Utils::write_string_to_sink(error_sink_handle, error_msg);
-                return -1;
-            }
-            const SpacetimeDb::ReducerDefinition& reducer_def = *reducer_def_ptr;
-
-            if (!reducer_def.invoker) {
-                std::string error_msg = "Reducer '" + reducer_def.spacetime_name + "' (ID: " + std::to_string(reducer_id) + ") has no invoker registered.";
-                std::cerr << "Error in __call_reducer__: " << error_msg << std::endl;
-                // Use error_sink_handle directly
-                SpacetimeDB::Abi::Utils::write_string_to_sink(error_sink_handle, error_msg);
-                return -2;
-            }
+        if (!entry) {
+            report_error(error_sink_handle, "Reducer with ID " + std::to_string(reducer_id) + " not found.");
+            return -1;
+        }
+        const SpacetimeDb::ReducerDefinition& reducer_def = *entry->definition;
 
-            // TODO: Set up ReducerContext if it becomes a thread_local or similar static instance
-            // ReducerContext::Current().set_identity(...);
-            // ReducerContext::Current().set_timestamp(timestamp);
+        if (!entry->invoker) {
+            report_error(error_sink_handle, "Reducer '" + reducer_def.spacetime_name + "' (ID: " +
+                                            std::to_string(reducer_id) + ") has no invoker registered.");
+            return -2;
+        }
 
-            reducer_def.invoker(reader);
+        // The context comes straight from the scalar parameters: the argument bytes hold
+        // only the reducer's own arguments.
+        spacetimedb::sdk::ReducerContext ctx(
+            spacetimedb::sdk::Identity::from_u64_words(
+                sender_identity_p0, sender_identity_p1, sender_identity_p2, sender_identity_p3),
+            SpacetimeDb::Types::u128::from_parts(connection_id_p1, connection_id_p0),
+            timestamp,
+            spacetimedb::sdk::reducer_database());
+
+        // Runs the invoker and reports malformed or unconsumed arguments and reducer errors.
+        // Generic so that a StreamingReader's own is_eos() (which checks the source too) is the
+        // one called.
+        auto invoke = [&](auto& reader) -> int16_t {
+            spacetimedb::sdk::ReducerResult result = entry->invoker(ctx, reader);
+
+            if (!reader.ok()) {
+                report_error(error_sink_handle, "Failed to decode arguments for reducer '" + reducer_def.spacetime_name +
+                    "' (ID: " + std::to_string(reducer_id) + "): " +
+                    SpacetimeDb::bsatn::decode_error_message(reader.error()));
+                return -5;
+            }
 
-            // ReducerContext::Current().reset(); // Clear context after call
+            if (!result) {
+                // The reducer's own message, as the host shows it to the caller. The status
+                // matches the Rust bindings for a reducer returning Err.
+                report_error(error_sink_handle, result.error().message);
+                return static_cast<int16_t>(SpacetimeDB::Abi::Errno::HostCallFailure);
+            }
 
             if (!reader.is_eos()) {
                 std::string warning_msg = "Warning: Reducer '" + reducer_def.spacetime_name + "' (ID: " +
@@ -97,32 +98,64 @@ extern "C" {
                 std::cerr << warning_msg << std::endl;
             }
             return 0; // Success
+        };
+
+        // Small payloads are read in one go. Large ones (bulk reducers) are decoded from a
+        // fixed-size window refilled from the host, so peak memory does not double, unless
+        // the reducer borrows views into its arguments, which need the whole buffer.
+        // Argument decoding reports malformed input through the reader's status, not exceptions.
+        if (entry->borrows_args ||
+            ::_bytes_source_get_remaining_count(args_source_handle) <= streaming_args_threshold) {
+            std::pmr::vector<std::byte> args_bytes =
+                SpacetimeDB::Abi::Utils::read_all_from_source(args_source_handle, spacetimedb::sdk::current_memory_resource());
+            SpacetimeDb::bsatn::Reader reader(args_bytes.data(), args_bytes.size(), SpacetimeDb::bsatn::ErrorMode::Status);
+            return invoke(reader);
+        }
+        SpacetimeDb::bsatn::StreamingReader reader(
+            [args_source_handle](std::span<std::byte> dest) {
+                return SpacetimeDB::Abi::Utils::read_from_source(args_source_handle, dest);
+            },
+            SpacetimeDb::bsatn::ErrorMode::Status);
+        return invoke(reader);
+    }
+}
+
+// Note: SPACETIMEDB_WASM_EXPORT is applied in the header "spacetime_module_exports.h"
+
+extern "C" {
 
+    int16_t __call_reducer__(
+        uint32_t reducer_id,
+        uint64_t sender_identity_p0,
+        uint64_t sender_identity_p1,
+        uint64_t sender_identity_p2,
+        uint64_t sender_identity_p3,
+        uint64_t connection_id_p0,
+        uint64_t connection_id_p1,
+        uint64_t timestamp,
+        BytesSource args_source_handle,
+        BytesSink error_sink_handle
+    ) {
+        // args_source_handle and error_sink_handle are externally managed.
+        // We don't use ManagedBytesSource/Sink for them here as they don't take existing handles.
+#ifdef SPACETIMEDB_NO_EXCEPTIONS
+        // Reducers report failure through their ReducerResult; SDK failures without a status abort.
+        return call_reducer(reducer_id, sender_identity_p0, sender_identity_p1, sender_identity_p2, sender_identity_p3,
+                            connection_id_p0, connection_id_p1, timestamp, args_source_handle, error_sink_handle);
+#else
+        try {
+            return call_reducer(reducer_id, sender_identity_p0, sender_identity_p1, sender_identity_p2, sender_identity_p3,
+                                connection_id_p0, connection_id_p1, timestamp, args_source_handle, error_sink_handle);
         }
         catch (const std::exception& e) {
-            std::string error_msg = "Exception during reducer execution (ID: " + std::to_string(reducer_id) + "): " + e.what();
-            std::cerr << "Error in __call_reducer__: " << error_msg << std::endl;
-            try {
-                // Use error_sink_handle directly
-                SpacetimeDB::Abi::Utils::write_string_to_sink(error_sink_handle, error_msg);
-            }
-            catch (const std::exception& sink_e) {
-                std::cerr << "Additionally, failed to write error to sink in __call_reducer__: " << sink_e.what() << std::endl;
-            }
+            report_error(error_sink_handle, "Exception during reducer execution (ID: " + std::to_string(reducer_id) + "): " + e.what());
             return -3;
         }
         catch (...) {
-            std::string error_msg = "Unknown exception during reducer execution (ID: " + std::to_string(reducer_id) + ").";
-            std::cerr << "Error in __call_reducer__: " << error_msg << std::endl;
-            try {
-                // Use error_sink_handle directly
-                SpacetimeDB::Abi::Utils::write_string_to_sink(error_sink_handle, error_msg);
-            }
-            catch (const std::exception& sink_e) {
-                std::cerr << "Additionally, failed to write error to sink in __call_reducer__: " << sink_e.what() << std::endl;
-            }
+            report_error(error_sink_handle, "Unknown exception during reducer execution (ID: " + std::to_string(reducer_id) + ").");
             return -4;
         }
+#endif
     }
 
 } // extern "C"
@@ -0,0 +1,76 @@
+#include "spacetimedb/sdk/batch_reducer.h"
+#include "spacetimedb/sdk/reducer_context.h" // For spacetimedb::sdk::ReducerContext
+
+#include <cstddef>  // For std::byte
+#include <iostream> // For the unconsumed-arguments warning
+#include <span>     // For std::span
+#include <vector>
+
+namespace SpacetimeDb::Internal {
+
+namespace {
+    spacetimedb::sdk::Error entry_error(uint32_t index, const std::string& reducer, const std::string& message,
+                                        uint16_t code = 0) {
+        return spacetimedb::sdk::Error{"batch[" + std::to_string(index) + "] " + reducer + ": " + message, code};
+    }
+}
+
+spacetimedb::sdk::ReducerResult invoke_batch(spacetimedb::sdk::ReducerContext& ctx, bsatn::Reader& reader) {
+    ModuleSchema& schema = ModuleSchema::instance();
+    uint32_t count = reader.read_vector_count();
+
+    for (uint32_t i = 0; i < count && reader.ok(); ++i) {
+        uint32_t reducer_id = reader.read_u32_le();
+        // A view into the batch's argument bytes, which are read whole (the reducer borrows them).
+        std::span<const std::byte> args = reader.read_bytes_span();
+        if (!reader.ok()) {
+            break; // Malformed batch; reported by __call_reducer__ from reader.error().
+        }
+
+        const ReducerDispatchEntry* entry = schema.reducer_by_id(reducer_id);
+        if (!entry || !entry->invoker) {
+            return entry_error(i, "reducer ID " + std::to_string(reducer_id), "not found");
+        }
+        const ReducerDefinition& def = *entry->definition;
+        if (entry->invoker == &invoke_batch) {
+            return entry_error(i, def.spacetime_name, "batches cannot be nested");
+        }
+        if (def.kind == ReducerKind::Init || def.kind == ReducerKind::ClientConnected ||
+            def.kind == ReducerKind::ClientDisconnected) {
+            return entry_error(i, def.spacetime_name, "lifecycle reducers cannot be called in a batch");
+        }
+
+        bsatn::Reader entry_reader(args.data(), args.size(), bsatn::ErrorMode::Status);
+        spacetimedb::sdk::ReducerResult result = entry->invoker(ctx, entry_reader);
+        if (!entry_reader.ok()) {
+            return entry_error(i, def.spacetime_name,
+                               std::string("failed to decode arguments: ") + bsatn::decode_error_message(entry_reader.error()));
+        }
+        if (!result) {
+            return entry_error(i, def.spacetime_name, result.error().message, result.error().code);
+        }
+        if (!entry_reader.is_eos()) {
+            std::cerr << "Warning: batch[" << i << "] " << def.spacetime_name << " did not consume all arguments. "
+                      << entry_reader.remaining_bytes() << " bytes remaining." << std::endl;
+        }
+    }
+    return {};
+}
+
+void register_batch_reducer(const std::string& spacetimedb_name) {
+    ModuleSchema& schema = ModuleSchema::instance();
+    schema.register_struct_type(batch_call_type_name, batch_call_type_name, {
+        FieldDefinition{"reducer_id", TypeIdentifier{CoreType::U32, ""}},
+        FieldDefinition{"args", TypeIdentifier{CoreType::Bytes, ""}},
+    });
+
+    ReducerParameterDefinition calls;
+    calls.name = "calls";
+    calls.type = TypeIdentifier{CoreType::UserDefined, batch_call_type_name};
+    calls.is_array = true;
+    // Borrowing: each entry's arguments are views into the batch's own argument bytes.
+    schema.register_reducer(spacetimedb_name, "invoke_batch", {calls}, &invoke_batch, ReducerKind::None,
+                            /*borrows_args=*/true);
+}
+
+} // namespace SpacetimeDb::Internal
@@ -0,0 +1,41 @@
+#include "spacetimedb/bsatn/sink_writer.h"
+#include "spacetimedb/internal/exceptions.h" // For SPACETIMEDB_NO_EXCEPTIONS
+
+#include <algorithm> // For std::max
+#include <utility>   // For std::move
+
+namespace SpacetimeDb {
+    namespace bsatn {
+
+        SinkWriter::SinkWriter(PushFn push, size_t buffer_size)
+            : SinkWriter(std::move(push), std::vector<std::byte>(std::max<size_t>(buffer_size, 64))) {}
+
+        SinkWriter::SinkWriter(PushFn push, std::vector<std::byte>&& storage)
+            : Writer(std::span<std::byte>(storage), &SinkWriter::flush_hook),
+              storage_(std::move(storage)),
+              push_(std::move(push)) {}
+
+        SinkWriter::~SinkWriter() {
+#ifdef SPACETIMEDB_NO_EXCEPTIONS
+            flush();
+#else
+            try {
+                flush();
+            } catch (...) {
+                // Destructors must not throw; call flush() explicitly to see sink errors.
+            }
+#endif
+        }
+
+        void SinkWriter::flush() {
+            flush_external();
+        }
+
+        void SinkWriter::flush_hook(Writer& writer, std::span<const std::byte> bytes) {
+            SinkWriter& self = static_cast<SinkWriter&>(writer);
+            self.push_(bytes);
+            self.pushed_ += bytes.size();
+        }
+
+    } // namespace bsatn
+} // namespace SpacetimeDb
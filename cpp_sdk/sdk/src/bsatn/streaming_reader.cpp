@@ -0,0 +1,52 @@
+#include "spacetimedb/bsatn/streaming_reader.h"
+
+#include <algorithm> // For std::max
+#include <cstring>   // For std::memmove
+#include <utility>   // For std::move
+
+namespace SpacetimeDb {
+    namespace bsatn {
+
+        StreamingReader::StreamingReader(PullFn pull, ErrorMode mode, size_t chunk_size)
+            : Reader(&StreamingReader::refill_hook, mode),
+              pull_(std::move(pull)),
+              chunk_size_(std::max<size_t>(chunk_size, 64)) {}
+
+        bool StreamingReader::is_eos() {
+            return remaining_bytes() == 0 && !refill(1);
+        }
+
+        bool StreamingReader::refill_hook(Reader& reader, size_t count) {
+            return static_cast<StreamingReader&>(reader).refill(count);
+        }
+
+        bool StreamingReader::refill(size_t count) {
+            // Move the unread tail to the front, growing the buffer only for a value larger than a chunk.
+            const size_t unread = remaining_bytes();
+            const size_t capacity = std::max(chunk_size_, count);
+            if (buffer_.empty()) {
+                buffer_.resize(capacity);
+            } else {
+                const size_t offset = static_cast<size_t>(window_begin() - buffer_.data());
+                if (unread != 0 && offset != 0) {
+                    std::memmove(buffer_.data(), buffer_.data() + offset, unread);
+                }
+                if (buffer_.size() < capacity) {
+                    buffer_.resize(capacity);
+                }
+            }
+
+            size_t filled = unread;
+            while (filled < count && !source_done_) {
+                size_t pulled = pull_(std::span<std::byte>(buffer_.data() + filled, buffer_.size() - filled));
+                if (pulled == 0) {
+                    source_done_ = true;
+                }
+                filled += pulled;
+            }
+            set_window(buffer_.data(), buffer_.data() + filled);
+            return filled >= count;
+        }
+
+    } // namespace bsatn
+} // namespace SpacetimeDb
@@ -1,15 +1,16 @@
 #include "spacetimedb/internal/module_def.h"    // Updated path
 #include "spacetimedb/internal/module_schema.h" // Updated path, For SpacetimeDb::ModuleSchema etc.
 #include "spacetimedb/bsatn/writer.h"           // Explicit include for bsatn::Writer, though module_def.h includes it
+#include "spacetimedb/internal/exceptions.h"    // For SpacetimeDb::Internal::raise
 
 #include <stdexcept> // For std::runtime_error
-#include <algorithm> // For std::transform (not currently used, but can be useful)
+#include <algorithm> // For std::any_of
 #include <vector>    // For std::vector
 #include <string>    // For std::string
 
-// Helper function to convert SpacetimeDb::CoreType to SpacetimeDB::Internal::InternalPrimitiveType
-SpacetimeDB::Internal::InternalPrimitiveType map_core_type_to_internal_primitive(SpacetimeDb::CoreType core_type) {
-    using InternalPT = SpacetimeDB::Internal::InternalPrimitiveType;
+// Helper function to convert SpacetimeDb::CoreType to SpacetimeDb::Internal::InternalPrimitiveType
+SpacetimeDb::Internal::InternalPrimitiveType map_core_type_to_internal_primitive(SpacetimeDb::CoreType core_type) {
+    using InternalPT = SpacetimeDb::Internal::InternalPrimitiveType;
     switch (core_type) {
         case SpacetimeDb::CoreType::Bool: return InternalPT::Bool;
         case SpacetimeDb::CoreType::U8:   return InternalPT::U8;
@@ -17,46 +18,48 @@ SpacetimeDB::Internal::InternalPrimitiveType map_core_type_to_internal_primitive
         case SpacetimeDb::CoreType::U32:  return InternalPT::U32;
         case SpacetimeDb::CoreType::U64:  return InternalPT::U64;
         case SpacetimeDb::CoreType::U128: return InternalPT::U128;
+        case SpacetimeDb::CoreType::U256: return InternalPT::U256;
         case SpacetimeDb::CoreType::I8:   return InternalPT::I8;
         case SpacetimeDb::CoreType::I16:  return InternalPT::I16;
         case SpacetimeDb::CoreType::I32:  return InternalPT::I32;
         case SpacetimeDb::CoreType::I64:  return InternalPT::I64;
         case SpacetimeDb::CoreType::I128: return InternalPT::I128;
+        case SpacetimeDb::CoreType::I256: return InternalPT::I256;
         case SpacetimeDb::CoreType::F32:  return InternalPT::F32;
         case SpacetimeDb::CoreType::F64:  return InternalPT::F64;
         case SpacetimeDb::CoreType::String: return InternalPT::String;
         case SpacetimeDb::CoreType::Bytes:  return InternalPT::Bytes;
         default:
-            throw std::runtime_error("Unsupported SpacetimeDb::CoreType for primitive mapping: " + std::to_string(static_cast<int>(core_type)));
+            SpacetimeDb::Internal::raise(std::runtime_error("Unsupported SpacetimeDb::CoreType for primitive mapping: " + std::to_string(static_cast<int>(core_type))));
     }
 }
 
-// Helper function to convert SpacetimeDb::TypeIdentifier to SpacetimeDB::Internal::InternalType
-SpacetimeDB::Internal::InternalType map_type_identifier_to_internal_type(
+// Helper function to convert SpacetimeDb::TypeIdentifier to SpacetimeDb::Internal::InternalType
+SpacetimeDb::Internal::InternalType map_type_identifier_to_internal_type(
     const SpacetimeDb::TypeIdentifier& type_id,
     const SpacetimeDb::ModuleSchema& user_schema
 ) {
     (void)user_schema; // user_schema not strictly needed in this simplified version
-    SpacetimeDB::Internal::InternalType internal_ty;
+    SpacetimeDb::Internal::InternalType internal_ty;
     if (type_id.core_type == SpacetimeDb::CoreType::UserDefined) {
-        internal_ty.kind = SpacetimeDB::Internal::InternalType::Kind::UserDefined;
+        internal_ty.kind = SpacetimeDb::Internal::InternalType::Kind::UserDefined;
         internal_ty.user_defined_name = type_id.user_defined_name;
     } else {
-        internal_ty.kind = SpacetimeDB::Internal::InternalType::Kind::Primitive;
+        internal_ty.kind = SpacetimeDb::Internal::InternalType::Kind::Primitive;
         internal_ty.primitive_type = map_core_type_to_internal_primitive(type_id.core_type);
     }
     return internal_ty;
 }
 
-SpacetimeDB::Internal::InternalType map_field_type_to_internal_type(
+SpacetimeDb::Internal::InternalType map_field_type_to_internal_type(
     const SpacetimeDb::FieldDefinition& field_def,
     const SpacetimeDb::ModuleSchema& user_schema
 ) {
-    SpacetimeDB::Internal::InternalType element_type = map_type_identifier_to_internal_type(field_def.type, user_schema);
+    SpacetimeDb::Internal::InternalType element_type = map_type_identifier_to_internal_type(field_def.type, user_schema);
     if (field_def.is_optional) {
-        SpacetimeDB::Internal::InternalType option_type;
-        option_type.kind = SpacetimeDB::Internal::InternalType::Kind::Option;
-        option_type.element_type = std::make_unique<SpacetimeDB::Internal::InternalType>(std::move(element_type));
+        SpacetimeDb::Internal::InternalType option_type;
+        option_type.kind = SpacetimeDb::Internal::InternalType::Kind::Option;
+        option_type.element_type = std::make_unique<SpacetimeDb::Internal::InternalType>(std::move(element_type));
         return option_type;
     }
     // TODO: Add mapping for Vector kind if FieldDefinition supports it explicitly
@@ -68,7 +71,121 @@ SpacetimeDB::Internal::InternalType map_field_type_to_internal_type(
 }
 
 
-SpacetimeDB::Internal::InternalModuleDef SpacetimeDB::Internal::build_internal_module_def(
+// Helpers for the per-table index, constraint and sequence definitions.
+// Generated names follow the host's canonical scheme so `index_id_from_name` finds them.
+static std::string join_column_names(const std::vector<std::string>& column_names) {
+    std::string joined;
+    for (size_t i = 0; i < column_names.size(); ++i) {
+        if (i > 0) joined += '_';
+        joined += column_names[i];
+    }
+    return joined;
+}
+
+static const char* index_algorithm_suffix(SpacetimeDb::IndexAlgorithm algorithm) {
+    switch (algorithm) {
+        case SpacetimeDb::IndexAlgorithm::BTree:  return "btree";
+        case SpacetimeDb::IndexAlgorithm::Hash:   return "hash";
+        case SpacetimeDb::IndexAlgorithm::Direct: return "direct";
+    }
+    SpacetimeDb::Internal::raise(std::runtime_error("Unknown SpacetimeDb::IndexAlgorithm: " + std::to_string(static_cast<int>(algorithm))));
+}
+
+static SpacetimeDb::Internal::ColId column_position(
+    const SpacetimeDb::StructDefinition& row_struct,
+    const std::string& table_name,
+    const std::string& field_name
+) {
+    for (size_t i = 0; i < row_struct.fields.size(); ++i) {
+        if (row_struct.fields[i].name == field_name) {
+            return static_cast<SpacetimeDb::Internal::ColId>(i);
+        }
+    }
+    SpacetimeDb::Internal::raise(std::runtime_error("Column '" + field_name + "' not found in row type '" + row_struct.cpp_name + "' of table '" + table_name + "'."));
+}
+
+static std::vector<SpacetimeDb::Internal::ColId> column_positions(
+    const SpacetimeDb::StructDefinition& row_struct,
+    const std::string& table_name,
+    const std::vector<std::string>& field_names
+) {
+    std::vector<SpacetimeDb::Internal::ColId> columns;
+    columns.reserve(field_names.size());
+    for (const auto& field_name : field_names) {
+        columns.push_back(column_position(row_struct, table_name, field_name));
+    }
+    return columns;
+}
+
+// Fills in indexes, unique constraints (primary key and `is_unique` fields) and sequences
+// (`is_auto_increment` fields). Every unique constraint is backed by a B-tree index unless
+// the table already declares an index on exactly those columns.
+static void add_table_constraints(
+    SpacetimeDb::Internal::InternalTableDef& table_def_internal,
+    const SpacetimeDb::TableDefinition& table_def_user,
+    const SpacetimeDb::StructDefinition& row_struct
+) {
+    using namespace SpacetimeDb::Internal;
+    const std::string& table_name = table_def_user.spacetime_name;
+
+    for (const auto& index_user : table_def_user.indexes) {
+        if (index_user.column_field_names.empty()) {
+            SpacetimeDb::Internal::raise(std::runtime_error("Index '" + index_user.index_name + "' on table '" + table_name + "' has no columns."));
+        }
+        if (index_user.algorithm == SpacetimeDb::IndexAlgorithm::Direct && index_user.column_field_names.size() != 1) {
+            SpacetimeDb::Internal::raise(std::runtime_error("Direct index '" + index_user.index_name + "' on table '" + table_name + "' must have exactly one column."));
+        }
+        InternalIndexDef index_internal;
+        index_internal.name = table_name + "_" + join_column_names(index_user.column_field_names) + "_idx_" + index_algorithm_suffix(index_user.algorithm);
+        if (!index_user.index_name.empty()) {
+            index_internal.accessor_name = index_user.index_name;
+        }
+        index_internal.algorithm = static_cast<InternalIndexAlgorithm>(index_user.algorithm);
+        index_internal.columns = column_positions(row_struct, table_name, index_user.column_field_names);
+        table_def_internal.indexes.push_back(index_internal);
+    }
+
+    std::vector<std::string> unique_fields;
+    if (!table_def_user.primary_key_field_name.empty()) {
+        unique_fields.push_back(table_def_user.primary_key_field_name);
+    }
+    for (const auto& field : row_struct.fields) {
+        if (field.is_unique && field.name != table_def_user.primary_key_field_name) {
+            unique_fields.push_back(field.name);
+        }
+    }
+
+    for (const auto& field_name : unique_fields) {
+        std::vector<ColId> columns{column_position(row_struct, table_name, field_name)};
+
+        InternalUniqueConstraintDef unique_internal;
+        unique_internal.name = table_name + "_" + field_name + "_key";
+        unique_internal.columns = columns;
+        table_def_internal.unique_constraints.push_back(unique_internal);
+
+        bool has_index = std::any_of(table_def_internal.indexes.begin(), table_def_internal.indexes.end(),
+                                     [&](const InternalIndexDef& index) { return index.columns == columns; });
+        if (!has_index) {
+            InternalIndexDef index_internal;
+            index_internal.name = table_name + "_" + field_name + "_idx_btree";
+            index_internal.algorithm = InternalIndexAlgorithm::BTree;
+            index_internal.columns = columns;
+            table_def_internal.indexes.push_back(index_internal);
+        }
+    }
+
+    for (size_t i = 0; i < row_struct.fields.size(); ++i) {
+        if (row_struct.fields[i].is_auto_increment) {
+            InternalSequenceDef sequence_internal;
+            sequence_internal.name = table_name + "_" + row_struct.fields[i].name + "_seq";
+            sequence_internal.column = static_cast<ColId>(i);
+            table_def_internal.sequences.push_back(sequence_internal);
+        }
+    }
+}
+
+
+SpacetimeDb::Internal::InternalModuleDef SpacetimeDb::Internal::build_internal_module_def(
     const SpacetimeDb::ModuleSchema& user_schema) {
     InternalModuleDef module_def_internal;
     module_def_internal.name = "module";
@@ -110,12 +227,17 @@ SpacetimeDB::Internal::InternalModuleDef SpacetimeDB::Internal::build_internal_m
         if (it_type != user_schema.types.end()) {
             table_def_internal.row_type_name = it_type->second.spacetime_db_name;
         } else {
-            throw std::runtime_error("Row type '" + table_def_user.cpp_row_type_name + "' not found for table '" + table_def_user.spacetime_name + "'.");
+            SpacetimeDb::Internal::raise(std::runtime_error("Row type '" + table_def_user.cpp_row_type_name + "' not found for table '" + table_def_user.spacetime_name + "'."));
+        }
+        if (!std::holds_alternative<SpacetimeDb::StructDefinition>(it_type->second.definition)) {
+            SpacetimeDb::Internal::raise(std::runtime_error("Row type '" + table_def_user.cpp_row_type_name + "' of table '" + table_def_user.spacetime_name + "' is not a struct."));
         }
 
         if (!table_def_user.primary_key_field_name.empty()) {
             table_def_internal.primary_key_field_name = table_def_user.primary_key_field_name;
         }
+        add_table_constraints(table_def_internal, table_def_user,
+                              std::get<SpacetimeDb::StructDefinition>(it_type->second.definition));
         module_def_internal.tables.push_back(table_def_internal);
     }
 
@@ -142,6 +264,12 @@ SpacetimeDB::Internal::InternalModuleDef SpacetimeDB::Internal::build_internal_m
             // For now, assume parameters are not optional unless their TypeIdentifier is already complex.
             temp_field_for_param_mapping.is_optional = false;
             param_internal.ty = map_field_type_to_internal_type(temp_field_for_param_mapping, user_schema);
+            if (param_user.is_array) {
+                SpacetimeDb::Internal::InternalType vector_type;
+                vector_type.kind = SpacetimeDb::Internal::InternalType::Kind::Vector;
+                vector_type.element_type = std::make_unique<SpacetimeDb::Internal::InternalType>(std::move(param_internal.ty));
+                param_internal.ty = std::move(vector_type);
+            }
 
             reducer_def_internal.parameters.push_back(param_internal);
         }
@@ -152,11 +280,11 @@ SpacetimeDB::Internal::InternalModuleDef SpacetimeDB::Internal::build_internal_m
 }
 
 // BSATN Serialization Implementations
-void SpacetimeDB::Internal::serialize(bsatn::Writer& writer, const InternalPrimitiveType& value) {
+void SpacetimeDb::Internal::serialize(bsatn::Writer& writer, const InternalPrimitiveType& value) {
     writer.write_u8(static_cast<uint8_t>(value));
 }
 
-void SpacetimeDB::Internal::serialize(bsatn::Writer& writer, const InternalType& type) {
+void SpacetimeDb::Internal::serialize(bsatn::Writer& writer, const InternalType& type) {
     writer.write_u8(static_cast<uint8_t>(type.kind));
     switch (type.kind) {
         case InternalType::Kind::Primitive:
@@ -167,38 +295,38 @@ void SpacetimeDB::Internal::serialize(bsatn::Writer& writer, const InternalType&
             break;
         case InternalType::Kind::Option:
         case InternalType::Kind::Vector:
-            if (!type.element_type) throw std::runtime_error("Option/Vector element_type is null during serialization.");
+            if (!type.element_type) SpacetimeDb::Internal::raise(std::runtime_error("Option/Vector element_type is null during serialization."));
             serialize(writer, *type.element_type);
             break;
         default:
-            throw std::runtime_error("Unknown InternalType::Kind for serialization");
+            SpacetimeDb::Internal::raise(std::runtime_error("Unknown InternalType::Kind for serialization"));
     }
 }
 
-void SpacetimeDB::Internal::serialize(bsatn::Writer& writer, const InternalFieldDef& def) {
+void SpacetimeDb::Internal::serialize(bsatn::Writer& writer, const InternalFieldDef& def) {
     writer.write_string(def.name);
     serialize(writer, def.ty);
 }
 
-void SpacetimeDB::Internal::serialize(bsatn::Writer& writer, const InternalEnumVariantDef& def) {
+void SpacetimeDb::Internal::serialize(bsatn::Writer& writer, const InternalEnumVariantDef& def) {
     writer.write_string(def.name);
 }
 
-void SpacetimeDB::Internal::serialize(bsatn::Writer& writer, const InternalStructDef& def) {
+void SpacetimeDb::Internal::serialize(bsatn::Writer& writer, const InternalStructDef& def) {
     writer.write_u32_le(static_cast<uint32_t>(def.fields.size()));
     for (const auto& field : def.fields) {
         serialize(writer, field);
     }
 }
 
-void SpacetimeDB::Internal::serialize(bsatn::Writer& writer, const InternalEnumDef& def) {
+void SpacetimeDb::Internal::serialize(bsatn::Writer& writer, const InternalEnumDef& def) {
     writer.write_u32_le(static_cast<uint32_t>(def.variants.size()));
     for (const auto& variant : def.variants) {
         serialize(writer, variant);
     }
 }
 
-void SpacetimeDB::Internal::serialize(bsatn::Writer& writer, const InternalTypeDef& def) {
+void SpacetimeDb::Internal::serialize(bsatn::Writer& writer, const InternalTypeDef& def) {
     writer.write_string(def.name);
     writer.write_u8(static_cast<uint8_t>(def.variant_kind));
     switch (def.variant_kind) {
@@ -209,11 +337,11 @@ void SpacetimeDB::Internal::serialize(bsatn::Writer& writer, const InternalTypeD
             serialize(writer, def.enum_def);
             break;
         default:
-            throw std::runtime_error("Unknown InternalTypeDefVariantKind for serialization");
+            SpacetimeDb::Internal::raise(std::runtime_error("Unknown InternalTypeDefVariantKind for serialization"));
     }
 }
 
-void SpacetimeDB::Internal::serialize(bsatn::Writer& writer, const InternalTableDef& def) {
+void SpacetimeDb::Internal::serialize(bsatn::Writer& writer, const InternalTableDef& def) {
     writer.write_string(def.name);
     writer.write_string(def.row_type_name);
 
@@ -222,14 +350,70 @@ void SpacetimeDB::Internal::serialize(bsatn::Writer& writer, const InternalTable
     if (has_pk) {
         writer.write_string(def.primary_key_field_name.value());
     }
+
+    writer.write_u32_le(static_cast<uint32_t>(def.indexes.size()));
+    for (const auto& index_def : def.indexes) {
+        serialize(writer, index_def);
+    }
+
+    writer.write_u32_le(static_cast<uint32_t>(def.unique_constraints.size()));
+    for (const auto& unique_def : def.unique_constraints) {
+        serialize(writer, unique_def);
+    }
+
+    writer.write_u32_le(static_cast<uint32_t>(def.sequences.size()));
+    for (const auto& sequence_def : def.sequences) {
+        serialize(writer, sequence_def);
+    }
+}
+
+static void serialize_col_list(SpacetimeDb::bsatn::Writer& writer, const std::vector<SpacetimeDb::Internal::ColId>& columns) {
+    writer.write_u32_le(static_cast<uint32_t>(columns.size()));
+    for (SpacetimeDb::Internal::ColId col : columns) {
+        writer.write_u16_le(col);
+    }
+}
+
+void SpacetimeDb::Internal::serialize(bsatn::Writer& writer, const InternalIndexDef& def) {
+    writer.write_string(def.name);
+
+    bool has_accessor = def.accessor_name.has_value();
+    writer.write_u8(static_cast<uint8_t>(has_accessor));
+    if (has_accessor) {
+        writer.write_string(def.accessor_name.value());
+    }
+
+    writer.write_u8(static_cast<uint8_t>(def.algorithm));
+    switch (def.algorithm) {
+        case InternalIndexAlgorithm::BTree:
+        case InternalIndexAlgorithm::Hash:
+            serialize_col_list(writer, def.columns);
+            break;
+        case InternalIndexAlgorithm::Direct:
+            if (def.columns.size() != 1) SpacetimeDb::Internal::raise(std::runtime_error("Direct index '" + def.name + "' must have exactly one column."));
+            writer.write_u16_le(def.columns[0]);
+            break;
+        default:
+            SpacetimeDb::Internal::raise(std::runtime_error("Unknown InternalIndexAlgorithm for serialization"));
+    }
+}
+
+void SpacetimeDb::Internal::serialize(bsatn::Writer& writer, const InternalUniqueConstraintDef& def) {
+    writer.write_string(def.name);
+    serialize_col_list(writer, def.columns);
+}
+
+void SpacetimeDb::Internal::serialize(bsatn::Writer& writer, const InternalSequenceDef& def) {
+    writer.write_string(def.name);
+    writer.write_u16_le(def.column);
 }
 
-void SpacetimeDB::Internal::serialize(bsatn::Writer& writer, const InternalReducerParameterDef& def) {
+void SpacetimeDb::Internal::serialize(bsatn::Writer& writer, const InternalReducerParameterDef& def) {
     writer.write_string(def.name);
     serialize(writer, def.ty);
 }
 
-void SpacetimeDB::Internal::serialize(bsatn::Writer& writer, const InternalReducerDef& def) {
+void SpacetimeDb::Internal::serialize(bsatn::Writer& writer, const InternalReducerDef& def) {
     writer.write_string(def.name);
     writer.write_u32_le(static_cast<uint32_t>(def.parameters.size()));
     for (const auto& param : def.parameters) {
@@ -237,7 +421,7 @@ void SpacetimeDB::Internal::serialize(bsatn::Writer& writer, const InternalReduc
     }
 }
 
-void SpacetimeDB::Internal::serialize(bsatn::Writer& writer, const InternalModuleDef& def) {
+void SpacetimeDb::Internal::serialize(bsatn::Writer& writer, const InternalModuleDef& def) {
     writer.write_string(def.name);
 
     writer.write_u32_le(static_cast<uint32_t>(def.types.size()));
@@ -256,11 +440,15 @@ void SpacetimeDB::Internal::serialize(bsatn::Writer& writer, const InternalModul
     }
 }
 
-std::vector<std::byte> SpacetimeDB::Internal::get_serialized_module_definition_bytes() {
+void SpacetimeDb::Internal::write_module_definition(bsatn::Writer& writer) {
     const SpacetimeDb::ModuleSchema& user_schema = SpacetimeDb::ModuleSchema::instance();
-    InternalModuleDef internal_module_def = build_internal_module_def(user_schema);
-    bsatn::Writer writer;
+    InternalModuleDef internal_module_def = build_internal_module_def(user_schema); // Validation errors are raised here, before any byte is written.
     serialize(writer, internal_module_def);
+}
+
+std::vector<std::byte> SpacetimeDb::Internal::get_serialized_module_definition_bytes() {
+    bsatn::Writer writer;
+    write_module_definition(writer);
     return writer.get_buffer(); // Use get_buffer() if take_buffer() is not what we want (e.g. if writer is reused)
                                 // Assuming getBytes() was a typo for get_buffer() or take_buffer() from bsatn::Writer
 }
@@ -0,0 +1,65 @@
+#include <spacetimedb/sdk/reducer_arena.h>
+#include <spacetimedb/internal/exceptions.h> // For SpacetimeDb::Internal::raise
+
+#include <algorithm> // For std::max
+#include <new>       // For std::bad_alloc
+
+namespace spacetimedb {
+namespace sdk {
+
+ReducerArena::ReducerArena(size_t chunk_size, size_t retained_size)
+    : chunk_size_(std::max<size_t>(chunk_size, 64)),
+      retained_size_(retained_size) {
+    chunks_.push_back(Chunk{std::make_unique_for_overwrite<std::byte[]>(chunk_size_), chunk_size_});
+    use_chunk(0);
+}
+
+void ReducerArena::use_chunk(size_t index) noexcept {
+    current_ = index;
+    cur_ = chunks_[index].data.get();
+    end_ = cur_ + chunks_[index].size;
+}
+
+void* ReducerArena::allocate_slow(size_t bytes, size_t alignment) {
+    if (bytes > SIZE_MAX - alignment) {
+        SpacetimeDb::Internal::raise(std::bad_alloc());
+    }
+    size_t needed = bytes + alignment; // Enough whatever the alignment of the chunk start.
+    size_t next = current_ + 1;
+    while (next < chunks_.size() && chunks_[next].size < needed) {
+        ++next; // Too small for this request; still used after the next reset.
+    }
+    if (next == chunks_.size()) {
+        size_t size = std::max(needed, chunks_.back().size * 2);
+        chunks_.push_back(Chunk{std::make_unique_for_overwrite<std::byte[]>(size), size});
+    }
+    use_chunk(next);
+    return do_allocate(bytes, alignment);
+}
+
+void ReducerArena::reset() noexcept {
+    size_t kept = 1;
+    size_t kept_size = chunks_[0].size;
+    while (kept < chunks_.size() && kept_size + chunks_[kept].size <= retained_size_) {
+        kept_size += chunks_[kept].size;
+        ++kept;
+    }
+    chunks_.resize(kept);
+    use_chunk(0);
+}
+
+size_t ReducerArena::capacity() const noexcept {
+    size_t total = 0;
+    for (const Chunk& chunk : chunks_) {
+        total += chunk.size;
+    }
+    return total;
+}
+
+ReducerArena& reducer_arena() {
+    static ReducerArena arena;
+    return arena;
+}
+
+} // namespace sdk
+} // namespace spacetimedb
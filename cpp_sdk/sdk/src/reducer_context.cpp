@@ -6,7 +6,8 @@ namespace sdk {
 
 ReducerContext::ReducerContext(Identity sender, Timestamp timestamp, Database& db_instance)
     : current_sender(std::move(sender)),
-      current_timestamp(timestamp),
+      current_connection_id(0),
+      current_timestamp_micros(timestamp.as_milliseconds() * 1000),
       database_instance(db_instance) {}
 
 const Identity& ReducerContext::get_sender() const {
@@ -14,7 +15,7 @@ const Identity& ReducerContext::get_sender() const {
 }
 
 Timestamp ReducerContext::get_timestamp() const {
-    return current_timestamp;
+    return Timestamp(current_timestamp_micros / 1000);
 }
 
 Database& ReducerContext::db() {
@@ -25,5 +26,10 @@ const Database& ReducerContext::db() const {
     return database_instance;
 }
 
+Database& reducer_database() {
+    static Database instance;
+    return instance;
+}
+
 } // namespace sdk
 } // namespace spacetimedb
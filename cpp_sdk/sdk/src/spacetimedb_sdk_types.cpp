@@ -4,6 +4,7 @@
 
 #include <vector>
 #include <array>
+#include <span>
 #include <stdexcept> // For std::runtime_error
 #include <algorithm> // For std::copy
 #include <cstddef>   // For std::byte
@@ -12,21 +13,63 @@ namespace SpacetimeDb {
     namespace sdk {
 
         // Identity
+        Identity::Identity() : value{} {}
+
+        Identity::Identity(const std::array<uint8_t, IDENTITY_SIZE>& bytes) : value(bytes) {}
+
+        const std::array<uint8_t, IDENTITY_SIZE>& Identity::get_bytes() const {
+            return value;
+        }
+
+        Identity Identity::from_u64_words(uint64_t w0, uint64_t w1, uint64_t w2, uint64_t w3) {
+            const uint64_t words[4] = {w0, w1, w2, w3};
+            Identity identity;
+            for (size_t i = 0; i < IDENTITY_SIZE; ++i) {
+                identity.value[i] = static_cast<uint8_t>(words[i / 8] >> ((i % 8) * 8));
+            }
+            return identity;
+        }
+
+        std::string Identity::to_hex_string() const {
+            static constexpr char hex_digits[] = "0123456789abcdef";
+            std::string hex;
+            hex.reserve(IDENTITY_SIZE * 2);
+            for (uint8_t byte : value) {
+                hex.push_back(hex_digits[byte >> 4]);
+                hex.push_back(hex_digits[byte & 0x0F]);
+            }
+            return hex;
+        }
+
+        bool Identity::operator==(const Identity& other) const { return value == other.value; }
+        bool Identity::operator!=(const Identity& other) const { return value != other.value; }
+        bool Identity::operator<(const Identity& other) const { return value < other.value; }
+
         void Identity::bsatn_serialize(::SpacetimeDb::bsatn::Writer& writer) const {
-            writer.write_bytes(std::vector<std::byte>(reinterpret_cast<const std::byte*>(this->value.data()), reinterpret_cast<const std::byte*>(this->value.data() + this->value.size())));
+            // The raw 32 bytes, without a length prefix, as bsatn_deserialize reads them.
+            writer.write_fixed_bytes(std::as_bytes(std::span(this->value)));
         }
         void Identity::bsatn_deserialize(::SpacetimeDb::bsatn::Reader& reader) {
             std::vector<std::byte> bytes = reader.read_fixed_bytes(IDENTITY_SIZE);
-            if (bytes.size() == IDENTITY_SIZE) {
+            if (bytes.size() == IDENTITY_SIZE) { // Otherwise the reader has already reported the short input.
                 std::copy(bytes.begin(), bytes.end(), reinterpret_cast<std::byte*>(this->value.data()));
             }
-            else {
-                // Consider a more robust error handling strategy for your application
-                throw std::runtime_error("Failed to read enough bytes for Identity");
-            }
         }
 
         // Timestamp
+        Timestamp::Timestamp() : ms_since_epoch(0) {}
+
+        Timestamp::Timestamp(uint64_t milliseconds_since_epoch) : ms_since_epoch(milliseconds_since_epoch) {}
+
+        uint64_t Timestamp::as_milliseconds() const { return ms_since_epoch; }
+
+        bool Timestamp::operator==(const Timestamp& other) const { return ms_since_epoch == other.ms_since_epoch; }
+        bool Timestamp::operator!=(const Timestamp& other) const { return ms_since_epoch != other.ms_since_epoch; }
+        bool Timestamp::operator<(const Timestamp& other) const { return ms_since_epoch < other.ms_since_epoch; }
+        bool Timestamp::operator<=(const Timestamp& other) const { return ms_since_epoch <= other.ms_since_epoch; }
+        bool Timestamp::operator>(const Timestamp& other) const { return ms_since_epoch > other.ms_since_epoch; }
+        bool Timestamp::operator>=(const Timestamp& other) const { return ms_since_epoch >= other.ms_since_epoch; }
+
         void Timestamp::bsatn_serialize(::SpacetimeDb::bsatn::Writer& writer) const {
             writer.write_u64_le(this->ms_since_epoch);
         }
@@ -44,14 +87,7 @@ namespace SpacetimeDb {
 
         // ConnectionId
         void ConnectionId::bsatn_serialize(::SpacetimeDb::bsatn::Writer& writer) const {
-            // Converting uint64_t to a byte array for write_bytes, little-endian.
-            std::array<std::byte, sizeof(this->id)> id_bytes;
-            uint64_t n = this->id;
-            for (size_t i = 0; i < sizeof(this->id); ++i) {
-                id_bytes[i] = static_cast<std::byte>(n & 0xFF);
-                n >>= 8;
-            }
-            writer.write_bytes(std::vector<std::byte>(id_bytes.begin(), id_bytes.end()));
+            writer.write_u64_le(this->id); // Fixed 8 bytes, as bsatn_deserialize reads them.
         }
         void ConnectionId::bsatn_deserialize(::SpacetimeDb::bsatn::Reader& reader) {
             std::vector<std::byte> id_bytes_vec = reader.read_fixed_bytes(sizeof(this->id));
@@ -61,9 +97,6 @@ namespace SpacetimeDb {
                     this->id |= static_cast<uint64_t>(static_cast<unsigned char>(id_bytes_vec[i])) << (i * 8);
                 }
             }
-            else {
-                throw std::runtime_error("Failed to read enough bytes for ConnectionId");
-            }
         }
 
         // TimeDuration
@@ -90,9 +123,6 @@ namespace SpacetimeDb {
             if (bytes.size() == sizeof(this->data)) {
                 std::copy(bytes.begin(), bytes.end(), reinterpret_cast<std::byte*>(this->data.data()));
             }
-            else {
-                throw std::runtime_error("Failed to read enough bytes for u256_placeholder");
-            }
         }
 
         // i256_placeholder
@@ -106,9 +136,6 @@ namespace SpacetimeDb {
             if (bytes.size() == sizeof(this->data)) {
                 std::copy(bytes.begin(), bytes.end(), reinterpret_cast<std::byte*>(this->data.data()));
             }
-            else {
-                throw std::runtime_error("Failed to read enough bytes for i256_placeholder");
-            }
         }
 
     } // namespace sdk
@@ -1,24 +1,92 @@
 #include "test_common.h"      // For ASSERT macros, host stubs, print_bytes_test_common
 #include "test_types.h"       // For SpacetimeDB::Test types
 #include "spacetimedb/sdk/logging.h"           // For SpacetimeDB::log_info etc.
-#include "spacetimedb/sdk/database.h"          // For SpacetimeDB::sdk::table_insert etc.
-#include "spacetimedb/internal/module_def.h"   // Updated path for SpacetimeDB::Internal::get_serialized_module_definition_bytes()
+#include "spacetimedb/sdk/database.h"          // For spacetimedb::sdk::table_insert etc.
+#include "spacetimedb/internal/module_def.h"   // Updated path for SpacetimeDb::Internal::get_serialized_module_definition_bytes()
 // spacetime_module_exports.h (for __describe_module__ etc.) is implicitly included via test_common.h
 #include "spacetimedb/bsatn/writer.h"          // For bsatn::Writer (updated to new path style)
 #include "spacetimedb/bsatn/reader.h"          // For bsatn::Reader (updated to new path style)
+#include "spacetimedb/bsatn/size.h"            // For bsatn::encoded_size
+#include "spacetimedb/bsatn/projection.h"      // For bsatn::skip, bsatn::deserialize_projected
+#include "spacetimedb/bsatn/streaming_reader.h" // For bsatn::StreamingReader
+#include "spacetimedb/bsatn/sink_writer.h"     // For bsatn::SinkWriter
 #include "spacetimedb/abi/abi_utils.h"         // For SpacetimeDB::Abi::Utils e.g. ManagedBytesSink
+#include "spacetimedb/sdk/row_iterator.h"      // For spacetimedb::sdk::RowIterator
+#include "spacetimedb/sdk/index_range.h"       // For spacetimedb::sdk::encode_index_eq
+#include "spacetimedb/sdk/reducer_context.h"   // For spacetimedb::sdk::ReducerContext
+#include "spacetimedb/sdk/reducer_arena.h"     // For spacetimedb::sdk::ReducerArena
+#include "spacetimedb/sdk/result.h"            // For spacetimedb::sdk::ReducerResult
+#include "spacetimedb/sdk/batch_reducer.h"     // For SPACETIMEDB_REDUCER_BATCH
 
 #include <iostream>
 #include <vector>
 #include <string>
 #include <optional>
+#include <array>
+#include <span>
 #include <stdexcept> // For std::out_of_range in error tests
 #include <numeric>   // For std::iota if needed for vector data
+#include <algorithm> // For std::equal
+
+namespace bsatn = SpacetimeDb::bsatn;
+
+// Row whose memory layout is its BSATN encoding (no padding, fields in order).
+namespace SpacetimeDB::Test {
+    struct BitwisePosition {
+        uint32_t id;
+        float x, y, z;
+    };
+}
+
+#define BITWISE_POSITION_FIELDS(XX, A, B) \
+    XX(A, B, uint32_t, id, false, false) \
+    XX(A, B, float, x, false, false) \
+    XX(A, B, float, y, false, false) \
+    XX(A, B, float, z, false, false)
+
+SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS(
+    SpacetimeDB::Test::BitwisePosition, SpacetimeDB_Test_BitwisePosition, "BitwisePosition",
+    BITWISE_POSITION_FIELDS,
+    ({
+        SPACETIMEDB_FIELD("id", SpacetimeDb::CoreType::U32, false, false),
+        SPACETIMEDB_FIELD("x", SpacetimeDb::CoreType::F32, false, false),
+        SPACETIMEDB_FIELD("y", SpacetimeDb::CoreType::F32, false, false),
+        SPACETIMEDB_FIELD("z", SpacetimeDb::CoreType::F32, false, false)
+    })
+)
+
+// One row type backing two tables: get_table<T>() is ambiguous, get_table<T>(name) is not.
+SPACETIMEDB_TABLE(SpacetimeDB::Test::BitwisePosition, "PositionsA", false)
+SPACETIMEDB_TABLE(SpacetimeDB::Test::BitwisePosition, "PositionsB", false)
+
+// Row that borrows its string and bytes from the buffer it was decoded from.
+namespace SpacetimeDB::Test {
+    struct BorrowedRow {
+        uint32_t id;
+        std::string_view name;
+        std::span<const std::byte> payload;
+    };
+}
+
+#define BORROWED_ROW_FIELDS(XX, A, B) \
+    XX(A, B, uint32_t, id, false, false) \
+    XX(A, B, std::string_view, name, false, false) \
+    XX(A, B, std::span<const std::byte>, payload, false, false)
+
+SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS(
+    SpacetimeDB::Test::BorrowedRow, SpacetimeDB_Test_BorrowedRow, "BorrowedRow",
+    BORROWED_ROW_FIELDS,
+    ({
+        SPACETIMEDB_FIELD("id", SpacetimeDb::CoreType::U32, false, false),
+        SPACETIMEDB_FIELD("name", SpacetimeDb::CoreType::String, false, false),
+        SPACETIMEDB_FIELD("payload", SpacetimeDb::CoreType::Bytes, false, false)
+    })
+)
 
 // --- BSATN Reader/Writer Primitive Tests ---
 void test_bsatn_primitives() {
     std::cout << "Running BSATN Primitive R/W Tests..." << std::endl;
-    using namespace SpacetimeDB::Types; // For uint128_t_placeholder etc.
+    using namespace SpacetimeDb::Types; // For uint128_t_placeholder etc.
 
     bsatn::Writer writer;
     writer.write_bool(true);
@@ -89,10 +157,10 @@ void test_macro_serialization() {
 
     BasicEnum enum_orig = BasicEnum::ValTwo;
     bsatn::Writer enum_writer;
-    SpacetimeDB::bsatn::serialize(enum_writer, enum_orig);
+    SpacetimeDb::bsatn::serialize(enum_writer, enum_orig);
     std::vector<std::byte> enum_bytes = enum_writer.take_buffer();
     bsatn::Reader enum_reader(enum_bytes);
-    BasicEnum enum_deser = SpacetimeDB::bsatn::deserialize_BasicEnum(enum_reader);
+    BasicEnum enum_deser = SpacetimeDb::bsatn::deserialize<BasicEnum>(enum_reader);
     ASSERT_EQ(enum_orig, enum_deser, "BasicEnum deserialize_BasicEnum");
     bsatn::Reader enum_reader_generic(enum_bytes);
     BasicEnum enum_deser_generic = bsatn::deserialize<BasicEnum>(enum_reader_generic);
@@ -100,10 +168,10 @@ void test_macro_serialization() {
 
     NestedData nested_orig = {123, "Test Nested", true};
     bsatn::Writer nested_writer;
-    SpacetimeDB::bsatn::serialize(nested_writer, nested_orig);
+    SpacetimeDb::bsatn::serialize(nested_writer, nested_orig);
     std::vector<std::byte> nested_bytes = nested_writer.take_buffer();
     bsatn::Reader nested_reader(nested_bytes);
-    NestedData nested_deser = SpacetimeDB::bsatn::deserialize_NestedData(nested_reader);
+    NestedData nested_deser = SpacetimeDb::bsatn::deserialize<NestedData>(nested_reader);
     ASSERT_EQ(nested_orig, nested_deser, "NestedData deserialize_NestedData");
     bsatn::Reader nested_reader_generic(nested_bytes);
     NestedData nested_deser_generic = bsatn::deserialize<NestedData>(nested_reader_generic);
@@ -125,11 +193,11 @@ void test_macro_serialization() {
     complex_orig.vec_opt_i32_field = {std::nullopt, 42, std::nullopt, -100};
 
     bsatn::Writer complex_writer;
-    SpacetimeDB::bsatn::serialize(complex_writer, complex_orig);
+    SpacetimeDb::bsatn::serialize(complex_writer, complex_orig);
     std::vector<std::byte> complex_bytes_vec = complex_writer.take_buffer(); // Renamed to avoid clash
     print_bytes_test_common(complex_bytes_vec, "Serialized ComplexType: ");
     bsatn::Reader complex_reader(complex_bytes_vec);
-    ComplexType complex_deser = SpacetimeDB::bsatn::deserialize_ComplexType(complex_reader);
+    ComplexType complex_deser = SpacetimeDb::bsatn::deserialize<ComplexType>(complex_reader);
 
     ASSERT_EQ(complex_orig.id_field, complex_deser.id_field, "ComplexType.id_field direct compare");
     ASSERT_EQ(complex_orig, complex_deser, "ComplexType (de)serialization (full object compare)");
@@ -140,11 +208,11 @@ void test_macro_serialization() {
     complex_orig_absent_opts.opt_nested_field.reset();
     complex_orig_absent_opts.opt_enum_field.reset();
     bsatn::Writer complex_writer_absent;
-    SpacetimeDB::bsatn::serialize(complex_writer_absent, complex_orig_absent_opts);
+    SpacetimeDb::bsatn::serialize(complex_writer_absent, complex_orig_absent_opts);
     std::vector<std::byte> complex_bytes_absent = complex_writer_absent.take_buffer();
     print_bytes_test_common(complex_bytes_absent, "Serialized ComplexType (absent optionals): ");
     bsatn::Reader complex_reader_absent(complex_bytes_absent);
-    ComplexType complex_deser_absent = SpacetimeDB::bsatn::deserialize_ComplexType(complex_reader_absent);
+    ComplexType complex_deser_absent = SpacetimeDb::bsatn::deserialize<ComplexType>(complex_reader_absent);
     ASSERT_EQ(complex_orig_absent_opts, complex_deser_absent, "ComplexType (de)serialization with absent optionals)");
 
     std::cout << "Macro (De)serialization Tests: SUCCESS" << std::endl;
@@ -156,10 +224,10 @@ static std::vector<std::string> g_reducer_call_log_test; // Renamed to avoid cla
 void test_reducer_simple_impl_unit(uint32_t val1, std::string val2) {
     g_reducer_call_log_test.push_back("test_reducer_simple_impl_unit called with: " + std::to_string(val1) + ", " + val2);
 }
-SPACETIMEDB_REDUCER("SimpleReducerUnit", test_reducer_simple_impl_unit, {
+SPACETIMEDB_REDUCER_NAMED("SimpleReducerUnit", test_reducer_simple_impl_unit, ({
     SPACETIMEDB_REDUCER_PARAM("val1", SpacetimeDb::CoreType::U32),
     SPACETIMEDB_REDUCER_PARAM("val2", SpacetimeDb::CoreType::String)
-}, uint32_t, std::string);
+}), uint32_t, std::string);
 
 
 void test_reducer_complex_args_impl_unit(const SpacetimeDB::Test::ReducerArgsTestStruct& s, bool b) {
@@ -170,10 +238,46 @@ void test_reducer_complex_args_impl_unit(const SpacetimeDB::Test::ReducerArgsTes
     }
      g_reducer_call_log_test.push_back("  vec_enum_arg size: " + std::to_string(s.vec_enum_arg.size()));
 }
-SPACETIMEDB_REDUCER("ComplexArgsReducerUnit", test_reducer_complex_args_impl_unit, {
+SPACETIMEDB_REDUCER_NAMED("ComplexArgsReducerUnit", test_reducer_complex_args_impl_unit, ({
     SPACETIMEDB_REDUCER_PARAM_CUSTOM("s", "TestReducerArgsStruct"),
     SPACETIMEDB_REDUCER_PARAM("b", SpacetimeDb::CoreType::Bool)
-}, SpacetimeDB::Test::ReducerArgsTestStruct, bool);
+}), SpacetimeDB::Test::ReducerArgsTestStruct, bool);
+
+static std::string g_context_reducer_log;
+static bool g_context_reducer_saw_arena = false;
+void test_reducer_context_impl_unit(spacetimedb::sdk::ReducerContext& ctx, uint32_t val) {
+    g_context_reducer_saw_arena = &ctx.arena() == &spacetimedb::sdk::reducer_arena();
+    const auto& sender = ctx.get_sender().get_bytes();
+    g_context_reducer_log = std::to_string(sender[0]) + "," + std::to_string(sender[31]) + "," +
+        ctx.get_connection_id().to_string() + "," + std::to_string(ctx.get_timestamp_micros()) + "," +
+        std::to_string(val);
+}
+SPACETIMEDB_REDUCER_NAMED("ContextReducerUnit", test_reducer_context_impl_unit, ({
+    SPACETIMEDB_REDUCER_PARAM("val", SpacetimeDb::CoreType::U32)
+}), uint32_t);
+
+static std::string g_borrowed_reducer_log;
+void test_reducer_borrowed_args_impl_unit(std::string_view key, std::span<const std::byte> blob) {
+    g_borrowed_reducer_log = std::string(key) + "," + std::to_string(blob.size()) + "," +
+        std::to_string(std::to_integer<int>(blob.back()));
+}
+SPACETIMEDB_REDUCER_NAMED("BorrowedArgsReducerUnit", test_reducer_borrowed_args_impl_unit, ({
+    SPACETIMEDB_REDUCER_PARAM("key", SpacetimeDb::CoreType::String),
+    SPACETIMEDB_REDUCER_PARAM("blob", SpacetimeDb::CoreType::Bytes)
+}), std::string_view, std::span<const std::byte>);
+
+spacetimedb::sdk::ReducerResult test_reducer_result_impl_unit(uint32_t amount) {
+    if (amount == 0) {
+        return spacetimedb::sdk::Error{"amount must be positive"};
+    }
+    g_reducer_call_log_test.push_back("test_reducer_result_impl_unit called with: " + std::to_string(amount));
+    return {};
+}
+SPACETIMEDB_REDUCER_NAMED("ResultReducerUnit", test_reducer_result_impl_unit, ({
+    SPACETIMEDB_REDUCER_PARAM("amount", SpacetimeDb::CoreType::U32)
+}), uint32_t);
+
+SPACETIMEDB_REDUCER_BATCH("BatchReducerUnit");
 
 
 void test_reducer_dispatch() {
@@ -182,23 +286,26 @@ void test_reducer_dispatch() {
 
     // Test SimpleReducerUnit
     bsatn::Writer writer_simple;
-    SpacetimeDB::bsatn::serialize(writer_simple, static_cast<uint32_t>(123));
-    SpacetimeDB::bsatn::serialize(writer_simple, std::string("hello_reducer_unit"));
+    SpacetimeDb::bsatn::serialize(writer_simple, static_cast<uint32_t>(123));
+    SpacetimeDb::bsatn::serialize(writer_simple, std::string("hello_reducer_unit"));
     std::vector<std::byte> args_simple_vec = writer_simple.take_buffer(); // Renamed
 
     BytesSource source_simple = _bytes_source_create_from_bytes(reinterpret_cast<const uint8_t*>(args_simple_vec.data()), args_simple_vec.size());
     BytesSink err_sink_simple = _bytes_sink_create();
 
-    // Find SimpleReducerUnit's ID (temporary method by iteration)
-    uint32_t simple_reducer_id = UINT32_MAX;
-    uint32_t current_id = 0;
-    for(const auto& pair : SpacetimeDb::ModuleSchema::instance().reducers) {
-        if (pair.first == "SimpleReducerUnit") {
-            simple_reducer_id = current_id;
-            break;
-        }
-        current_id++;
+    // Reducer ids are positions in the ModuleDef's reducer list; the dispatch table must agree.
+    auto& schema = SpacetimeDb::ModuleSchema::instance();
+    const auto& dispatch_table = schema.reducer_dispatch_table();
+    SpacetimeDb::Internal::InternalModuleDef built_def = SpacetimeDb::Internal::build_internal_module_def(schema);
+    ASSERT_EQ(dispatch_table.size(), built_def.reducers.size(), "Dispatch table covers every ModuleDef reducer");
+    for (size_t i = 0; i < dispatch_table.size(); ++i) {
+        ASSERT_EQ(dispatch_table[i].definition->spacetime_name, built_def.reducers[i].name, "Dispatch table order matches ModuleDef");
+        ASSERT_EQ(schema.reducer_id(built_def.reducers[i].name), static_cast<uint32_t>(i), "reducer_id is the ModuleDef position");
     }
+    ASSERT_EQ(schema.reducer_id("NoSuchReducerUnit"), UINT32_MAX, "Unknown reducer name has no id");
+    ASSERT_NULL(schema.reducer_by_id(static_cast<uint32_t>(dispatch_table.size())), "Out-of-range reducer id has no entry");
+
+    uint32_t simple_reducer_id = schema.reducer_id("SimpleReducerUnit");
     ASSERT_NE(simple_reducer_id, UINT32_MAX, "SimpleReducerUnit ID not found for dispatch test");
 
     int16_t status_simple = __call_reducer__(simple_reducer_id, 0,0,0,0,0,0,0, source_simple, err_sink_simple);
@@ -218,22 +325,14 @@ void test_reducer_dispatch() {
     complex_arg_s.vec_enum_arg = {SpacetimeDB::Test::BasicEnum::ValOne, SpacetimeDB::Test::BasicEnum::ValTwo};
 
     bsatn::Writer writer_complex;
-    SpacetimeDB::bsatn::serialize(writer_complex, complex_arg_s);
-    SpacetimeDB::bsatn::serialize(writer_complex, true);
+    SpacetimeDb::bsatn::serialize(writer_complex, complex_arg_s);
+    SpacetimeDb::bsatn::serialize(writer_complex, true);
     std::vector<std::byte> args_complex_vec = writer_complex.take_buffer(); // Renamed
 
     BytesSource source_complex = _bytes_source_create_from_bytes(reinterpret_cast<const uint8_t*>(args_complex_vec.data()), args_complex_vec.size());
     BytesSink err_sink_complex = _bytes_sink_create();
 
-    uint32_t complex_reducer_id = UINT32_MAX;
-    current_id = 0;
-    for(const auto& pair : SpacetimeDb::ModuleSchema::instance().reducers) {
-        if (pair.first == "ComplexArgsReducerUnit") {
-            complex_reducer_id = current_id;
-            break;
-        }
-        current_id++;
-    }
+    uint32_t complex_reducer_id = schema.reducer_id("ComplexArgsReducerUnit");
     ASSERT_NE(complex_reducer_id, UINT32_MAX, "ComplexArgsReducerUnit ID not found for dispatch test");
 
     int16_t status_complex = __call_reducer__(complex_reducer_id, 0,0,0,0,0,0,0, source_complex, err_sink_complex);
@@ -253,7 +352,7 @@ void test_module_def_abi() {
     // Ensure schema is populated by macros in test_types.h and reducers in this file.
     // (This happens due to static initialization order when these files are linked.)
 
-    std::vector<std::byte> direct_def_bytes = SpacetimeDB::Internal::get_serialized_module_definition_bytes();
+    std::vector<std::byte> direct_def_bytes = SpacetimeDb::Internal::get_serialized_module_definition_bytes();
     ASSERT_TRUE(direct_def_bytes.size() > 0, "Serialized ModuleDef (direct) should not be empty.");
     print_bytes_test_common(direct_def_bytes, "Serialized ModuleDef (direct): ");
 
@@ -270,6 +369,102 @@ void test_module_def_abi() {
     std::cout << "ModuleDef Generation/ABI Tests (Unit): SUCCESS" << std::endl;
 }
 
+namespace {
+    const SpacetimeDb::Internal::InternalTableDef* find_table_def(
+        const SpacetimeDb::Internal::InternalModuleDef& module_def, const std::string& name) {
+        for (const auto& table : module_def.tables) {
+            if (table.name == name) return &table;
+        }
+        return nullptr;
+    }
+
+    std::vector<std::string> index_names(const SpacetimeDb::Internal::InternalTableDef& table) {
+        std::vector<std::string> names;
+        for (const auto& index : table.indexes) names.push_back(index.name);
+        return names;
+    }
+}
+
+void test_module_def_constraints() {
+    std::cout << "Running ModuleDef Constraint Naming Tests (Unit)..." << std::endl;
+    using namespace SpacetimeDb::Internal;
+
+    // Tables as registered by the macros in test_types.h.
+    InternalModuleDef module_def = build_internal_module_def(SpacetimeDb::ModuleSchema::instance());
+
+    const InternalTableDef* nested = find_table_def(module_def, "MyNestedTable");
+    ASSERT_NOT_NULL(nested, "MyNestedTable is in the ModuleDef.");
+    ASSERT_EQ(index_names(*nested), std::vector<std::string>{"MyNestedTable_item_id_idx_btree"},
+              "The primary key gets a backing btree index.");
+    ASSERT_EQ(nested->unique_constraints.size(), size_t{1}, "The primary key is a unique constraint.");
+    ASSERT_EQ(nested->unique_constraints[0].name, std::string("MyNestedTable_item_id_key"), "Unique constraint name.");
+    ASSERT_TRUE(nested->sequences.empty(), "No auto-increment column, no sequence.");
+
+    const InternalTableDef* indexed = find_table_def(module_def, "IndexedTable");
+    ASSERT_NOT_NULL(indexed, "IndexedTable is in the ModuleDef.");
+    ASSERT_EQ(indexed->primary_key_field_name, std::optional<std::string>("id"), "Primary key field.");
+    ASSERT_EQ(index_names(*indexed),
+              (std::vector<std::string>{"IndexedTable_x_idx_btree", "IndexedTable_x_y_idx_btree", "IndexedTable_y_idx_direct",
+                                        "IndexedTable_handle_idx_hash", "IndexedTable_id_idx_btree"}),
+              "User indexes first, then a backing btree index per unique column without one.");
+    ASSERT_EQ(indexed->indexes[1].accessor_name, std::optional<std::string>("by_xy"), "The user's index name is the accessor.");
+    ASSERT_EQ(indexed->indexes[1].columns, (std::vector<uint16_t>{2, 3}), "Index column positions.");
+    ASSERT_FALSE(indexed->indexes[4].accessor_name.has_value(), "Backing indexes have no accessor.");
+    ASSERT_EQ(indexed->unique_constraints.size(), size_t{2}, "Primary key and unique column.");
+    ASSERT_EQ(indexed->unique_constraints[0].name, std::string("IndexedTable_id_key"), "Primary key constraint comes first.");
+    ASSERT_EQ(indexed->unique_constraints[1].name, std::string("IndexedTable_handle_key"), "Unique column constraint.");
+    ASSERT_EQ(indexed->sequences.size(), size_t{1}, "One auto-increment column.");
+    ASSERT_EQ(indexed->sequences[0].name, std::string("IndexedTable_id_seq"), "Sequence name.");
+    ASSERT_EQ(indexed->sequences[0].column, uint16_t{0}, "Sequence column.");
+
+    // BSATN field order of the table: name, row type, primary key, indexes, unique constraints, sequences.
+    bsatn::Writer writer;
+    serialize(writer, *indexed);
+    std::vector<std::byte> bytes = writer.take_buffer();
+    bsatn::Reader reader(bytes);
+    ASSERT_EQ(reader.read_string(), std::string("IndexedTable"), "Table name.");
+    ASSERT_EQ(reader.read_string(), std::string("IndexedRow"), "Row type name.");
+    ASSERT_EQ(reader.read_u8(), uint8_t{1}, "Primary key is Some.");
+    ASSERT_EQ(reader.read_string(), std::string("id"), "Primary key field.");
+
+    ASSERT_EQ(reader.read_u32_le(), uint32_t{5}, "Index count.");
+    const std::vector<std::vector<uint16_t>> index_columns{{2}, {2, 3}, {3}, {1}, {0}};
+    const std::vector<std::string> accessors{"by_x", "by_xy", "by_y", "by_handle", ""};
+    const std::vector<uint8_t> algorithms{0, 0, 2, 1, 0};
+    for (size_t i = 0; i < 5; ++i) {
+        ASSERT_EQ(reader.read_string(), indexed->indexes[i].name, "Index name.");
+        bool has_accessor = !accessors[i].empty();
+        ASSERT_EQ(reader.read_u8(), uint8_t{has_accessor}, "Index accessor option tag.");
+        if (has_accessor) {
+            ASSERT_EQ(reader.read_string(), accessors[i], "Index accessor name.");
+        }
+        ASSERT_EQ(reader.read_u8(), algorithms[i], "Index algorithm tag.");
+        if (algorithms[i] == 2) {
+            ASSERT_EQ(reader.read_u16_le(), index_columns[i][0], "Direct index column.");
+        } else {
+            ASSERT_EQ(reader.read_u32_le(), static_cast<uint32_t>(index_columns[i].size()), "Index column count.");
+            for (uint16_t column : index_columns[i]) {
+                ASSERT_EQ(reader.read_u16_le(), column, "Index column.");
+            }
+        }
+    }
+
+    ASSERT_EQ(reader.read_u32_le(), uint32_t{2}, "Unique constraint count.");
+    ASSERT_EQ(reader.read_string(), std::string("IndexedTable_id_key"), "First unique constraint name.");
+    ASSERT_EQ(reader.read_u32_le(), uint32_t{1}, "First unique constraint column count.");
+    ASSERT_EQ(reader.read_u16_le(), uint16_t{0}, "First unique constraint column.");
+    ASSERT_EQ(reader.read_string(), std::string("IndexedTable_handle_key"), "Second unique constraint name.");
+    ASSERT_EQ(reader.read_u32_le(), uint32_t{1}, "Second unique constraint column count.");
+    ASSERT_EQ(reader.read_u16_le(), uint16_t{1}, "Second unique constraint column.");
+
+    ASSERT_EQ(reader.read_u32_le(), uint32_t{1}, "Sequence count.");
+    ASSERT_EQ(reader.read_string(), std::string("IndexedTable_id_seq"), "Sequence name.");
+    ASSERT_EQ(reader.read_u16_le(), uint16_t{0}, "Sequence column.");
+    ASSERT_TRUE(reader.is_eos(), "The table encoding ends after the sequences.");
+
+    std::cout << "ModuleDef Constraint Naming Tests (Unit): SUCCESS" << std::endl;
+}
+
 // --- SDK Runtime Wrapper Tests ---
 void test_sdk_runtime_wrappers() {
     std::cout << "Running SDK Runtime Wrapper Tests (Unit)..." << std::endl;
@@ -285,35 +480,1174 @@ void test_sdk_runtime_wrappers() {
         ASSERT_TRUE(g_host_log_messages.back().find("[HOST STUB _log_message_abi (ERROR)] Testing error log via SDK (Unit).") != std::string::npos, "Error log content check");
     }
 
-    SpacetimeDB::Test::NestedData row_to_insert = {222, "Insert SDK Unit"};
+    SpacetimeDB::Test::NestedData row_to_insert = {222, "Insert SDK Unit", std::nullopt};
     // Note: spacetimedb::sdk::table_insert is in spacetimedb::sdk namespace
     bool insert_success = spacetimedb::sdk::table_insert("MyNestedTable", row_to_insert);
     ASSERT_TRUE(insert_success, "table_insert should return true on stub success.");
     ASSERT_FALSE(g_host_table_ops_log.empty(), "table_insert should log a host table op.");
     if (!g_host_table_ops_log.empty()) {
-        ASSERT_TRUE(g_host_table_ops_log.back().find("table_insert Table: MyNestedTable") != std::string::npos, "table_insert op log check");
+        ASSERT_TRUE(g_host_table_ops_log.back().find("_insert Table: MyNestedTable") != std::string::npos, "table_insert op log check");
     }
 
     std::string pk_to_delete = "key_to_delete_unit";
     bool delete_success = spacetimedb::sdk::table_delete_by_pk<std::string>("AnotherTableUnit", pk_to_delete);
     ASSERT_TRUE(delete_success, "table_delete_by_pk should return true on stub success.");
     ASSERT_FALSE(g_host_table_ops_log.empty(), "table_delete_by_pk should log a host table op.");
-     if (g_host_table_ops_log.size() >=2 ) {
-        ASSERT_TRUE(g_host_table_ops_log.back().find("table_delete_by_pk Table: AnotherTableUnit") != std::string::npos, "table_delete_by_pk op log check");
+    if (g_host_table_ops_log.size() >=2 ) {
+        ASSERT_TRUE(g_host_table_ops_log.back().find("datastore_delete_by_index_scan_range_bsatn Index: AnotherTableUnit_key_idx_btree") != std::string::npos, "table_delete_by_pk op log check");
     }
 
     std::cout << "SDK Runtime Wrapper Tests (Unit): SUCCESS" << std::endl;
 }
 
+// --- Batched Row Iteration Tests ---
+void test_row_iterator_batching() {
+    std::cout << "Running Batched Row Iteration Tests (Unit)..." << std::endl;
+    using namespace SpacetimeDB::Test;
+
+    std::vector<NestedData> expected_rows = {
+        {1, "first", true}, {2, "second", false}, {3, "a considerably longer third row name", std::nullopt}
+    };
+    const uint32_t iter_handle = 42;
+    auto load_mock_iter = [&]() {
+        g_mock_row_iters[iter_handle] = {};
+        g_mock_row_iters_pos[iter_handle] = 0;
+        for (const auto& row : expected_rows) {
+            bsatn::Writer row_writer;
+            SpacetimeDb::bsatn::serialize(row_writer, row);
+            g_mock_row_iters[iter_handle].push_back(row_writer.take_buffer());
+        }
+    };
+    g_mock_row_iters_closed.clear();
+    load_mock_iter();
+
+    // Start with a buffer too small for any row to exercise the BUFFER_TOO_SMALL path.
+    g_mock_row_iter_advance_calls = 0;
+    std::vector<NestedData> seen_rows;
+    {
+        spacetimedb::sdk::RowIterator<NestedData> rows(::RowIter{iter_handle}, 4);
+        for (const NestedData& row : rows) {
+            seen_rows.push_back(row);
+        }
+        ASSERT_TRUE(rows.is_exhausted(), "RowIterator exhausted after range-for");
+    }
+    ASSERT_EQ(seen_rows, expected_rows, "RowIterator yields all rows in order");
+    ASSERT_TRUE(g_mock_row_iter_advance_calls < 2 * expected_rows.size() + 1, "RowIterator batches host calls");
+    ASSERT_TRUE(g_mock_row_iters_closed.empty(), "Exhausted RowIterator must not close the host iterator");
+
+    // Dropping an iterator early closes the host handle.
+    load_mock_iter();
+    {
+        spacetimedb::sdk::RowIterator<NestedData> rows(::RowIter{iter_handle}, 16);
+        ASSERT_TRUE(rows.next(), "RowIterator first row available");
+        ASSERT_EQ(rows.current(), expected_rows[0], "RowIterator first row matches");
+    }
+    ASSERT_EQ(g_mock_row_iters_closed.size(), 1, "Early-dropped RowIterator closes the host iterator");
+
+    // A projection skips the unselected field (here the name) and leaves it empty.
+    load_mock_iter();
+    {
+        spacetimedb::sdk::RowIterator<NestedData> rows(::RowIter{iter_handle}, 16,
+                                                        SpacetimeDb::bsatn::FieldMask{~uint64_t{0b10}});
+        size_t i = 0;
+        for (const NestedData& row : rows) {
+            NestedData expected = expected_rows[i];
+            expected.item_name.clear();
+            ASSERT_EQ(row, expected, "Projected row skips the unselected field");
+            ++i;
+        }
+        ASSERT_EQ(i, expected_rows.size(), "Projected RowIterator yields every row");
+    }
+
+    std::cout << "Batched Row Iteration Tests (Unit): SUCCESS" << std::endl;
+}
+
+
+// --- Index Range Tests (mock host) ---
+// BSATN bytes written by `fill`, for comparing against the arguments the mock host recorded.
+template<typename Fill>
+std::vector<std::byte> encoded_bytes(Fill fill) {
+    bsatn::Writer writer;
+    fill(writer);
+    return writer.take_buffer();
+}
+
+void test_index_range_scans() {
+    std::cout << "Running Index Range Scan Tests (Unit)..." << std::endl;
+    using namespace SpacetimeDB::Test;
+    using spacetimedb::sdk::Range;
+    const uint32_t index_id = g_mock_index_ids["MyNestedTable_item_id_idx_btree"];
+    spacetimedb::sdk::Table<NestedData> table(g_mock_table_ids["MyNestedTable"]);
+    const std::vector<std::byte> no_bytes;
+    const std::vector<std::byte> unbounded = {std::byte{2}};
+    g_mock_index_scan_calls.clear();
+    g_mock_index_scan_rows.clear();
+
+    // Included start, excluded end, with one prefix column.
+    for (const NestedData& row : table.scan_range(index_id, std::make_tuple(uint32_t{5}), Range<std::string>::half_open("a", "m"))) {
+        (void)row;
+    }
+    ASSERT_EQ(g_mock_index_scan_calls.size(), 1, "scan_range makes one host call");
+    const MockIndexRangeCall& half_open = g_mock_index_scan_calls.back();
+    ASSERT_EQ(half_open.index_id, index_id, "scan_range passes the index id");
+    ASSERT_EQ(half_open.prefix_elems, 1, "One prefix column");
+    ASSERT_TRUE(half_open.prefix == encoded_bytes([](bsatn::Writer& w) { w.write_u32_le(5); }), "Prefix is the BSATN key");
+    ASSERT_TRUE(half_open.rstart == encoded_bytes([](bsatn::Writer& w) { w.write_u8(0); w.write_string("a"); }), "Included start: tag 0 + value");
+    ASSERT_TRUE(half_open.rend == encoded_bytes([](bsatn::Writer& w) { w.write_u8(1); w.write_string("m"); }), "Excluded end: tag 1 + value");
+
+    // Unbounded ends are a bare tag; without a prefix the prefix is empty.
+    for (const NestedData& row : table.scan_range(index_id, Range<uint32_t>::at_least(10))) { (void)row; }
+    const MockIndexRangeCall& at_least = g_mock_index_scan_calls.back();
+    ASSERT_EQ(at_least.prefix_elems, 0, "No prefix columns");
+    ASSERT_TRUE(at_least.prefix == no_bytes, "Empty prefix");
+    ASSERT_TRUE(at_least.rstart == encoded_bytes([](bsatn::Writer& w) { w.write_u8(0); w.write_u32_le(10); }), "at_least start");
+    ASSERT_TRUE(at_least.rend == unbounded, "at_least end is unbounded");
+
+    for (const NestedData& row : table.scan_range(index_id, Range<uint32_t>::all())) { (void)row; }
+    ASSERT_TRUE(g_mock_index_scan_calls.back().rstart == unbounded && g_mock_index_scan_calls.back().rend == unbounded,
+                "all() is unbounded on both ends");
+
+    for (const NestedData& row : table.scan_range(index_id, Range<uint32_t>::greater_than(3))) { (void)row; }
+    ASSERT_TRUE(g_mock_index_scan_calls.back().rstart == encoded_bytes([](bsatn::Writer& w) { w.write_u8(1); w.write_u32_le(3); }),
+                "greater_than start is excluded");
+
+    // scan_prefix: all but the last key go in the prefix, the last is the range [key, key].
+    for (const NestedData& row : table.scan_prefix(index_id, uint32_t{7})) { (void)row; }
+    const MockIndexRangeCall& one_key = g_mock_index_scan_calls.back();
+    const std::vector<std::byte> included_7 = encoded_bytes([](bsatn::Writer& w) { w.write_u8(0); w.write_u32_le(7); });
+    ASSERT_TRUE(one_key.prefix_elems == 0 && one_key.prefix == no_bytes, "Single-key prefix scan has no prefix");
+    ASSERT_TRUE(one_key.rstart == included_7 && one_key.rend == included_7, "Single key is an inclusive point range");
+
+    for (const NestedData& row : table.scan_prefix(index_id, std::string("zone"), uint32_t{7})) { (void)row; }
+    const MockIndexRangeCall& two_keys = g_mock_index_scan_calls.back();
+    ASSERT_EQ(two_keys.prefix_elems, 1, "Two keys: one prefix column");
+    ASSERT_TRUE(two_keys.prefix == encoded_bytes([](bsatn::Writer& w) { w.write_string("zone"); }), "Leading key in the prefix");
+    ASSERT_TRUE(two_keys.rstart == included_7 && two_keys.rend == included_7, "Last key is the point range");
+
+    // encode_index_eq encodes the same whether it owns its buffer or borrows a Writer.
+    bsatn::Writer scratch;
+    spacetimedb::sdk::EncodedIndexRange borrowed = spacetimedb::sdk::encode_index_eq(scratch, std::make_tuple(std::string("zone"), uint32_t{7}));
+    spacetimedb::sdk::EncodedIndexRange owned = spacetimedb::sdk::encode_index_eq(std::make_tuple(std::string("zone"), uint32_t{7}));
+    ASSERT_EQ(owned.prefix_elems(), borrowed.prefix_elems(), "Same prefix column count");
+    ASSERT_TRUE(std::equal(owned.prefix_ptr(), owned.end_ptr() + owned.end_len(), borrowed.prefix_ptr(), borrowed.end_ptr() + borrowed.end_len()),
+                "Same bytes");
+    ASSERT_TRUE(owned.prefix_len() == two_keys.prefix.size() && owned.start_len() == two_keys.rstart.size() &&
+                owned.end_len() == two_keys.rend.size(), "Same split as the scan_prefix call");
+
+    // The scan's rows are decoded from the iterator the host returned.
+    std::vector<NestedData> expected_rows = {{1, "first", true}, {2, "second", std::nullopt}};
+    for (const NestedData& row : expected_rows) {
+        g_mock_index_scan_rows.push_back(encoded_bytes([&](bsatn::Writer& w) { SpacetimeDb::bsatn::serialize(w, row); }));
+    }
+    std::vector<NestedData> seen_rows;
+    for (const NestedData& row : table.scan_range(index_id, Range<uint32_t>::closed(1, 2))) {
+        seen_rows.push_back(row);
+    }
+    ASSERT_TRUE(seen_rows == expected_rows, "Rows from the range scan");
+    g_mock_index_scan_rows.clear();
+
+    // A failed host call is an error carrying the host code.
+    g_mock_index_scan_status = 5; // NO_SUCH_INDEX
+    auto failed = table.try_scan_range(index_id, Range<uint32_t>::all());
+    ASSERT_TRUE(!failed && failed.error().code == 5, "try_scan_range reports the host error");
+    g_mock_index_scan_status = 0;
+
+    // String literal keys are encoded as strings, as prefix columns and as the last key.
+    spacetimedb::sdk::Table<KeyedRow> keyed(g_mock_table_ids["AnotherTableUnit"]);
+    const uint32_t key_index_id = g_mock_index_ids["AnotherTableUnit_key_idx_btree"];
+    const std::vector<std::byte> included_key = encoded_bytes([](bsatn::Writer& w) { w.write_u8(0); w.write_string("key"); });
+    g_mock_index_scan_calls.clear();
+    g_mock_index_scan_rows = {encoded_bytes([](bsatn::Writer& w) { SpacetimeDb::bsatn::serialize(w, KeyedRow{"key", 9}); })};
+    std::optional<KeyedRow> literal_found = keyed.find_unique(key_index_id, "key");
+    ASSERT_TRUE(literal_found.has_value() && literal_found->value == 9, "find_unique with a literal key");
+    ASSERT_TRUE(g_mock_index_scan_calls.back().rstart == included_key && g_mock_index_scan_calls.back().rend == included_key,
+                "A literal last key is a string point range");
+    for (const KeyedRow& row : keyed.scan_prefix(key_index_id, "a")) { (void)row; }
+    ASSERT_TRUE(g_mock_index_scan_calls.back().rstart == encoded_bytes([](bsatn::Writer& w) { w.write_u8(0); w.write_string("a"); }),
+                "scan_prefix with a literal key");
+    const char* c_key = "key";
+    (void)keyed.scan_prefix(key_index_id, "zone", c_key);
+    ASSERT_TRUE(g_mock_index_scan_calls.back().prefix == encoded_bytes([](bsatn::Writer& w) { w.write_string("zone"); }) &&
+                g_mock_index_scan_calls.back().rstart == included_key, "Literal prefix and C string last key");
+    g_mock_index_scan_rows.clear();
+
+    std::cout << "Index Range Scan Tests (Unit): SUCCESS" << std::endl;
+}
+
+void test_index_range_deletes() {
+    std::cout << "Running Index Range Delete Tests (Unit)..." << std::endl;
+    using namespace SpacetimeDB::Test;
+    using spacetimedb::sdk::Range;
+    const uint32_t index_id = g_mock_index_ids["MyNestedTable_item_id_idx_btree"];
+    spacetimedb::sdk::Table<NestedData> table(g_mock_table_ids["MyNestedTable"]);
+    g_mock_index_delete_calls.clear();
+    g_mock_index_scan_calls.clear();
+
+    // The host's deleted count is returned, and the range is encoded like a scan's.
+    g_mock_index_delete_count = 3;
+    uint32_t deleted = table.delete_range(index_id, std::make_tuple(std::string("zone")), Range<uint32_t>::less_than(100));
+    ASSERT_EQ(deleted, 3u, "delete_range returns the host's deleted count");
+    ASSERT_EQ(g_mock_index_delete_calls.size(), 1, "delete_range makes one host call");
+    ASSERT_TRUE(g_mock_index_scan_calls.empty(), "No rows are scanned back into the module");
+    const MockIndexRangeCall& range_call = g_mock_index_delete_calls.back();
+    ASSERT_EQ(range_call.index_id, index_id, "delete_range passes the index id");
+    ASSERT_EQ(range_call.prefix_elems, 1, "One prefix column");
+    ASSERT_TRUE(range_call.prefix == encoded_bytes([](bsatn::Writer& w) { w.write_string("zone"); }), "Prefix is the BSATN key");
+    ASSERT_TRUE(range_call.rstart == std::vector<std::byte>{std::byte{2}}, "less_than start is unbounded");
+    ASSERT_TRUE(range_call.rend == encoded_bytes([](bsatn::Writer& w) { w.write_u8(1); w.write_u32_le(100); }), "less_than end is excluded");
+
+    // delete_by_prefix deletes the inclusive point range of its last key.
+    g_mock_index_delete_count = 0;
+    ASSERT_EQ(table.delete_by_prefix(index_id, uint32_t{42}), 0u, "No matching rows: zero deleted");
+    const std::vector<std::byte> included_42 = encoded_bytes([](bsatn::Writer& w) { w.write_u8(0); w.write_u32_le(42); });
+    const MockIndexRangeCall& prefix_call = g_mock_index_delete_calls.back();
+    ASSERT_TRUE(prefix_call.prefix_elems == 0 && prefix_call.prefix.empty(), "Single key has no prefix");
+    ASSERT_TRUE(prefix_call.rstart == included_42 && prefix_call.rend == included_42, "Single key is an inclusive point range");
+
+    // A failed host call is an error carrying the host code.
+    g_mock_index_delete_status = 5; // NO_SUCH_INDEX
+    auto failed = table.try_delete_range(index_id, Range<uint32_t>::all());
+    ASSERT_TRUE(!failed && failed.error().code == 5, "try_delete_range reports the host error");
+    g_mock_index_delete_status = 0;
+
+    std::cout << "Index Range Delete Tests (Unit): SUCCESS" << std::endl;
+}
+
+void test_table_row_count() {
+    std::cout << "Running Table Row Count Tests (Unit)..." << std::endl;
+    using namespace SpacetimeDB::Test;
+    spacetimedb::sdk::Table<NestedData> table(g_mock_table_ids["MyNestedTable"]);
+    g_host_table_ops_log.clear();
+
+    // count() is the host's row count, for this table, in one call.
+    g_mock_row_count = 12345678901ULL;
+    ASSERT_EQ(table.count(), 12345678901ULL, "count() passes the host's u64 through");
+    ASSERT_EQ(g_host_table_ops_log.size(), 1, "count() makes one host call");
+    ASSERT_EQ(g_host_table_ops_log.back(), "datastore_table_row_count Table: MyNestedTable", "count() passes the table id");
+
+    // A failed host call is an error carrying the host code, or an exception from count().
+    g_mock_row_count_status = 2; // NOT_IN_TRANSACTION
+    auto failed = table.try_count();
+    ASSERT_TRUE(!failed && failed.error().code == 2, "try_count reports the host error");
+    bool count_threw = false;
+    try { (void)table.count(); } catch (const std::runtime_error&) { count_threw = true; }
+    ASSERT_TRUE(count_threw, "count() throws on a host error");
+
+    // collect() sizes its result from the count; a count error stops it before the scan.
+    g_host_table_ops_log.clear();
+    auto collect_failed = table.try_collect();
+    ASSERT_TRUE(!collect_failed && collect_failed.error().code == 2, "try_collect reports the count error");
+    ASSERT_EQ(g_host_table_ops_log.size(), 1, "No scan after a failed count");
+    g_mock_row_count_status = 0;
+
+    std::vector<NestedData> expected_rows = {{1, "first", true}, {2, "second", false}, {3, "third", std::nullopt}};
+    for (const NestedData& row : expected_rows) {
+        g_mock_table_scan_rows.push_back(encoded_bytes([&](bsatn::Writer& w) { SpacetimeDb::bsatn::serialize(w, row); }));
+    }
+    g_mock_row_count = expected_rows.size();
+    std::vector<NestedData> collected = table.collect();
+    ASSERT_TRUE(collected == expected_rows, "collect() returns every row");
+    ASSERT_EQ(collected.capacity(), expected_rows.size(), "collect() reserves exactly the row count");
+    g_mock_table_scan_rows.clear();
+    g_mock_row_count = 0;
+
+    // A malformed row is an error from try_collect() and an exception from collect().
+    g_mock_table_scan_rows.push_back({std::byte{0x01}});
+    g_mock_row_count = 1;
+    auto malformed = table.try_collect();
+    ASSERT_TRUE(!malformed && malformed.error().message.find("deserialization failed") != std::string::npos,
+                "try_collect reports a malformed row");
+    bool collect_threw = false;
+    try { (void)table.collect(); } catch (const std::runtime_error&) { collect_threw = true; }
+    ASSERT_TRUE(collect_threw, "collect() throws on a malformed row");
+    auto scan = table.try_iter_batched();
+    ASSERT_TRUE(scan && scan->next() == false && !scan->ok(), "try_iter_batched reports a malformed row through ok()");
+    g_mock_table_scan_rows.clear();
+    g_mock_row_count = 0;
+
+    std::cout << "Table Row Count Tests (Unit): SUCCESS" << std::endl;
+}
+
+void test_database_get_table() {
+    std::cout << "Running Database Get Table Tests (Unit)..." << std::endl;
+    using namespace SpacetimeDB::Test;
+    spacetimedb::sdk::Database db;
+
+    // The registered table of a row type is resolved once, then cached.
+    using NestedCache = SpacetimeDb::Internal::TableIdCache<NestedData>;
+    g_host_table_ops_log.clear();
+    (void)db.get_table<NestedData>().count();
+    ASSERT_TRUE(NestedCache::resolved && NestedCache::id == g_mock_table_ids["MyNestedTable"], "get_table<T>() caches the id");
+    ASSERT_EQ(g_host_table_ops_log.back(), "datastore_table_row_count Table: MyNestedTable", "get_table<T>() finds the table");
+
+    auto unregistered = db.try_get_table<ComplexType>();
+    ASSERT_TRUE(!unregistered && unregistered.error().message.find("not registered") != std::string::npos,
+                "A row type without a table is an error");
+
+    // A row type registered for two tables must be named.
+    using PositionCache = SpacetimeDb::Internal::TableIdCache<BitwisePosition>;
+    ASSERT_TRUE(PositionCache::ambiguous, "Registering a row type twice marks it ambiguous");
+    auto ambiguous = db.try_get_table<BitwisePosition>();
+    ASSERT_TRUE(!ambiguous && ambiguous.error().message.find("several tables") != std::string::npos,
+                "get_table<T>() rejects an ambiguous row type");
+    bool ambiguous_threw = false;
+    try { (void)db.get_table<BitwisePosition>(); } catch (const std::runtime_error&) { ambiguous_threw = true; }
+    ASSERT_TRUE(ambiguous_threw, "get_table<T>() throws for an ambiguous row type");
+    ASSERT_FALSE(PositionCache::resolved, "An ambiguous row type is never cached");
+
+    (void)db.get_table<BitwisePosition>("PositionsA").count();
+    ASSERT_EQ(g_host_table_ops_log.back(), "datastore_table_row_count Table: PositionsA", "get_table<T>(name) picks the first table");
+    (void)db.get_table<BitwisePosition>("PositionsB").count();
+    ASSERT_EQ(g_host_table_ops_log.back(), "datastore_table_row_count Table: PositionsB", "get_table<T>(name) picks the second table");
+
+    std::cout << "Database Get Table Tests (Unit): SUCCESS" << std::endl;
+}
+
+void test_table_find_unique() {
+    std::cout << "Running Table Find Unique Tests (Unit)..." << std::endl;
+    using namespace SpacetimeDB::Test;
+    const uint32_t index_id = g_mock_index_ids["MyNestedTable_item_id_idx_btree"];
+    const uint32_t table_id = g_mock_table_ids["MyNestedTable"];
+    spacetimedb::sdk::Table<NestedData> table(table_id);
+    const NestedData first{7, "seven", true};
+    const NestedData second{8, "eight", false};
+    auto row_bytes = [](const NestedData& row) {
+        return encoded_bytes([&](bsatn::Writer& w) { SpacetimeDb::bsatn::serialize(w, row); });
+    };
+
+    // Index overload: an empty scan is nullopt.
+    g_mock_index_scan_calls.clear();
+    g_mock_index_scan_rows.clear();
+    ASSERT_TRUE(!table.find_unique(index_id, uint32_t{7}).has_value(), "Empty index scan: nullopt");
+    ASSERT_EQ(g_mock_index_scan_calls.size(), 1, "One index scan per lookup");
+    const std::vector<std::byte> included_7 = encoded_bytes([](bsatn::Writer& w) { w.write_u8(0); w.write_u32_le(7); });
+    const MockIndexRangeCall& lookup = g_mock_index_scan_calls.back();
+    ASSERT_TRUE(lookup.index_id == index_id && lookup.prefix_elems == 0, "Lookup scans the given index without prefix");
+    ASSERT_TRUE(lookup.rstart == included_7 && lookup.rend == included_7, "Key is an inclusive point range");
+
+    // One matching row is decoded; only the first is decoded if the host returns more.
+    g_mock_index_scan_rows = {row_bytes(first)};
+    std::optional<NestedData> found = table.find_unique(index_id, uint32_t{7});
+    ASSERT_TRUE(found.has_value() && *found == first, "Index lookup decodes the matching row");
+    g_mock_index_scan_rows = {row_bytes(first), row_bytes(second)};
+    found = table.find_unique(index_id, uint32_t{7});
+    ASSERT_TRUE(found.has_value() && *found == first, "Index lookup decodes exactly one row");
+
+    // An empty batch that is not the last is not a miss; the lookup advances again.
+    g_mock_row_iter_empty_batches = 2;
+    found = table.find_unique(index_id, uint32_t{7});
+    ASSERT_TRUE(found.has_value() && *found == first, "Index lookup advances past empty batches");
+    ASSERT_EQ(g_mock_row_iter_empty_batches, 0u, "Every empty batch was consumed");
+
+    // Multi-column keys: leading keys form the prefix.
+    (void)table.find_unique(index_id, std::string("zone"), uint32_t{7});
+    ASSERT_EQ(g_mock_index_scan_calls.back().prefix_elems, 1, "Leading key is a prefix column");
+    ASSERT_TRUE(g_mock_index_scan_calls.back().prefix == encoded_bytes([](bsatn::Writer& w) { w.write_string("zone"); }),
+                "Leading key bytes");
+    g_mock_index_scan_rows.clear();
+
+    g_mock_index_scan_status = 5; // NO_SUCH_INDEX
+    auto failed = table.try_find_unique(index_id, uint32_t{7});
+    ASSERT_TRUE(!failed && failed.error().code == 5, "try_find_unique reports the host error");
+    g_mock_index_scan_status = 0;
+
+    // Column overload: an empty result buffer is nullopt.
+    g_mock_col_eq_calls.clear();
+    g_mock_col_eq_rows.clear();
+    ASSERT_TRUE(!table.find_unique<0>(uint32_t{7}).has_value(), "No matching column value: nullopt");
+    ASSERT_EQ(g_mock_col_eq_calls.size(), 1, "One column lookup");
+    ASSERT_TRUE(g_mock_col_eq_calls.back().table_id == table_id && g_mock_col_eq_calls.back().col_id == 0,
+                "Column lookup passes the table and column");
+    ASSERT_TRUE(g_mock_col_eq_calls.back().value == encoded_bytes([](bsatn::Writer& w) { w.write_u32_le(7); }),
+                "Column lookup passes the BSATN key");
+
+    g_mock_col_eq_rows = {row_bytes(first)};
+    found = table.find_unique<0>(uint32_t{7});
+    ASSERT_TRUE(found.has_value() && *found == first, "Column lookup decodes the matching row");
+    g_mock_col_eq_rows = {row_bytes(first), row_bytes(second)};
+    found = table.find_unique<0>(uint32_t{7});
+    ASSERT_TRUE(found.has_value() && *found == first, "Column lookup decodes exactly one row");
+    ASSERT_TRUE(g_mock_buffers.empty(), "Host buffers are consumed");
+
+    // find_by_col_eq decodes every match from the one buffer, without asking for the row count.
+    g_host_table_ops_log.clear();
+    std::vector<NestedData> matches = table.find_by_col_eq(0, uint32_t{7});
+    ASSERT_TRUE(matches == (std::vector<NestedData>{first, second}), "find_by_col_eq decodes every match");
+    ASSERT_TRUE(g_host_table_ops_log.empty(), "find_by_col_eq makes no row count call");
+    g_mock_col_eq_rows.clear();
+
+    std::cout << "Table Find Unique Tests (Unit): SUCCESS" << std::endl;
+}
+
 
 // Main function to run all unit tests
+void test_bsatn_zero_copy_views() {
+    std::cout << "Running BSATN Zero-Copy View Tests..." << std::endl;
+
+    bsatn::Writer writer;
+    writer.write_string(std::string_view("borrowed key"));
+    writer.write_bytes(std::vector<std::byte>{std::byte{0xDE}, std::byte{0xAD}, std::byte{0xBE}});
+    writer.write_string("");
+    writer.write_u32_le(7);
+    std::vector<std::byte> buffer = writer.take_buffer();
+    const std::byte* buffer_begin = buffer.data();
+    const std::byte* buffer_end = buffer.data() + buffer.size();
+
+    bsatn::Reader reader(buffer);
+    std::string_view key = reader.read_string_view();
+    ASSERT_EQ(key, std::string_view("borrowed key"), "string_view read");
+    ASSERT_TRUE(reinterpret_cast<const std::byte*>(key.data()) >= buffer_begin &&
+                reinterpret_cast<const std::byte*>(key.data()) < buffer_end, "string_view points into the source buffer");
+
+    std::span<const std::byte> blob = reader.read_bytes_span();
+    ASSERT_EQ(blob.size(), 3, "bytes span size");
+    ASSERT_TRUE(blob[0] == std::byte{0xDE} && blob[2] == std::byte{0xBE}, "bytes span content");
+    ASSERT_TRUE(blob.data() >= buffer_begin && blob.data() + blob.size() <= buffer_end, "bytes span points into the source buffer");
+
+    ASSERT_TRUE(SpacetimeDb::bsatn::deserialize<std::string_view>(reader).empty(), "empty string_view via deserialize<T>");
+    ASSERT_EQ(reader.read_u32_le(), 7, "read after views stays aligned");
+    ASSERT_TRUE(reader.is_eos(), "Reader EOS after view reads");
+
+    // Views are validated exactly like their owning counterparts.
+    bsatn::Writer writer_short;
+    writer_short.write_u32_le(16);
+    writer_short.write_u8(0x41);
+    std::vector<std::byte> short_buf = writer_short.take_buffer();
+    bsatn::Reader reader_short(short_buf);
+    try { reader_short.read_string_view(); ASSERT_TRUE(false, "Should have thrown on truncated string_view"); }
+    catch (const std::out_of_range&) { /* Expected */ }
+
+    // A row type declared with view fields round-trips through the struct macros, its fields
+    // decoded as views into the row's buffer; the owning row type encodes identically.
+    using SpacetimeDB::Test::BorrowedRow;
+    const std::vector<std::byte> payload = {std::byte{0x01}, std::byte{0x02}};
+    BorrowedRow row_orig{9, "view row", payload};
+    bsatn::Writer row_writer;
+    SpacetimeDb::bsatn::serialize(row_writer, row_orig);
+    std::vector<std::byte> row_buffer = row_writer.take_buffer();
+
+    bsatn::Writer owned_writer;
+    SpacetimeDb::bsatn::serialize(owned_writer, row_orig.id);
+    SpacetimeDb::bsatn::serialize(owned_writer, std::string("view row"));
+    SpacetimeDb::bsatn::serialize(owned_writer, payload);
+    ASSERT_TRUE(row_buffer == owned_writer.take_buffer(), "View fields encode like string and bytes");
+
+    bsatn::Reader row_reader(row_buffer);
+    BorrowedRow row_decoded = SpacetimeDb::bsatn::deserialize<BorrowedRow>(row_reader);
+    ASSERT_TRUE(row_reader.is_eos(), "Reader EOS after view row");
+    ASSERT_EQ(row_decoded.id, 9u, "View row scalar field");
+    ASSERT_EQ(row_decoded.name, std::string_view("view row"), "View row string_view field");
+    ASSERT_TRUE(std::equal(row_decoded.payload.begin(), row_decoded.payload.end(), payload.begin(), payload.end()),
+                "View row bytes field");
+    const std::byte* row_begin = row_buffer.data();
+    const std::byte* row_end = row_buffer.data() + row_buffer.size();
+    ASSERT_TRUE(reinterpret_cast<const std::byte*>(row_decoded.name.data()) >= row_begin &&
+                reinterpret_cast<const std::byte*>(row_decoded.name.data()) < row_end, "View row name points into the row buffer");
+    ASSERT_TRUE(row_decoded.payload.data() >= row_begin && row_decoded.payload.data() + row_decoded.payload.size() <= row_end,
+                "View row payload points into the row buffer");
+
+    std::cout << "BSATN Zero-Copy View Tests: SUCCESS" << std::endl;
+}
+
+void test_bsatn_writer_external_buffer() {
+    std::cout << "Running BSATN Writer External Buffer Tests..." << std::endl;
+
+    std::array<std::byte, 8> storage{};
+    bsatn::Writer fixed_writer{std::span<std::byte>(storage)};
+    fixed_writer.write_u32_le(0xABCDEF01);
+    fixed_writer.write_u16_le(0x1234);
+    ASSERT_TRUE(fixed_writer.uses_external_buffer(), "Writer targets the caller buffer");
+    ASSERT_EQ(fixed_writer.size(), 6, "External writer size");
+    ASSERT_TRUE(fixed_writer.data() == storage.data(), "External writer writes in place");
+    try { fixed_writer.write_u32_le(1); ASSERT_TRUE(false, "Should have thrown on external buffer overflow"); }
+    catch (const std::runtime_error&) { /* Expected */ }
+    ASSERT_EQ(fixed_writer.size(), 6, "Failed write leaves the size unchanged");
+
+    bsatn::Writer spilling_writer(std::span<std::byte>(storage), bsatn::OverflowPolicy::SpillToHeap);
+    spilling_writer.write_u32_le(7);
+    spilling_writer.write_string("spilled to heap");
+    ASSERT_FALSE(spilling_writer.uses_external_buffer(), "Writer spilled to its own vector");
+    bsatn::Reader reader(spilling_writer.view());
+    ASSERT_EQ(reader.read_u32_le(), 7, "Bytes written before the spill are kept");
+    ASSERT_EQ(reader.read_string(), "spilled to heap", "Bytes written after the spill");
+    ASSERT_TRUE(reader.is_eos(), "Reader EOS after spilled data");
+
+    // reset() keeps the capacity, so a reused writer does not reallocate.
+    bsatn::Writer reused_writer;
+    reused_writer.reserve(64);
+    reused_writer.write_u64_le(1);
+    const std::byte* first_data = reused_writer.data();
+    reused_writer.reset();
+    ASSERT_EQ(reused_writer.size(), 0, "reset() empties the writer");
+    reused_writer.write_u64_le(2);
+    ASSERT_TRUE(reused_writer.data() == first_data, "reset() keeps the storage");
+
+    std::cout << "BSATN Writer External Buffer Tests: SUCCESS" << std::endl;
+}
+
+void test_bsatn_encoded_size() {
+    std::cout << "Running BSATN Encoded Size Tests..." << std::endl;
+    using SpacetimeDb::bsatn::encoded_size;
+
+    static_assert(encoded_size<uint32_t>() == 4, "u32 is fixed-size");
+    static_assert(encoded_size<SpacetimeDb::Types::uint128_t_placeholder>() == 16, "u128 is fixed-size");
+    static_assert(!SpacetimeDb::bsatn::is_fixed_size_v<std::string>, "strings are variable-size");
+
+    ASSERT_EQ(encoded_size(std::string("hello")), 4 + 5, "string size");
+    ASSERT_EQ(encoded_size(std::vector<uint16_t>{1, 2, 3}), 4 + 3 * 2, "fixed-element vector size");
+    ASSERT_EQ(encoded_size(std::vector<std::string>{"a", "bc"}), 4 + (4 + 1) + (4 + 2), "variable-element vector size");
+    ASSERT_EQ(encoded_size(std::optional<uint64_t>{}), 1, "empty optional size");
+    ASSERT_EQ(encoded_size(std::optional<uint64_t>{7}), 1 + 8, "present optional size");
+
+    // Fixed-size SDK types: the constant matches what bsatn_serialize writes, and round-trips.
+    using SpacetimeDb::sdk::Identity;
+    using SpacetimeDb::sdk::Timestamp;
+    using SpacetimeDb::sdk::ConnectionId;
+    static_assert(encoded_size<Identity>() == 32, "Identity is 32 bytes");
+    static_assert(encoded_size<Timestamp>() == 8, "Timestamp is 8 bytes");
+    static_assert(encoded_size<ConnectionId>() == 8, "ConnectionId is 8 bytes");
+    static_assert(encoded_size<SpacetimeDb::sdk::ScheduleAt>() == 8, "ScheduleAt is 8 bytes");
+    static_assert(encoded_size<SpacetimeDb::sdk::TimeDuration>() == 8, "TimeDuration is 8 bytes");
+    const Identity identity = Identity::from_u64_words(1, 2, 3, 4);
+    const Timestamp timestamp(1700000000000ULL);
+    const ConnectionId connection_id(0x0102030405060708ULL);
+    bsatn::Writer sdk_writer;
+    SpacetimeDb::bsatn::serialize(sdk_writer, identity);
+    ASSERT_EQ(sdk_writer.size(), 32, "Identity writes its 32 bytes without a length prefix");
+    SpacetimeDb::bsatn::serialize(sdk_writer, timestamp);
+    SpacetimeDb::bsatn::serialize(sdk_writer, connection_id);
+    ASSERT_EQ(sdk_writer.size(), 32 + 8 + 8, "Timestamp and ConnectionId write 8 bytes each");
+    bsatn::Reader sdk_reader(sdk_writer.view());
+    ASSERT_TRUE(SpacetimeDb::bsatn::deserialize<Identity>(sdk_reader) == identity, "Identity round-trips");
+    ASSERT_TRUE(SpacetimeDb::bsatn::deserialize<Timestamp>(sdk_reader) == timestamp, "Timestamp round-trips");
+    ASSERT_TRUE(SpacetimeDb::bsatn::deserialize<ConnectionId>(sdk_reader) == connection_id, "ConnectionId round-trips");
+    ASSERT_TRUE(sdk_reader.is_eos(), "SDK types consume exactly their fixed size");
+    ASSERT_EQ(encoded_size(std::vector<Identity>(3, identity)), 4 + 3 * 32, "Vector of identities is sized without serializing");
+
+    // Generated size_traits must agree with the generated serialize().
+    using namespace SpacetimeDB::Test;
+    for (const NestedData& row : {NestedData{1, "first", true}, NestedData{2, "", std::nullopt}}) {
+        bsatn::Writer writer;
+        SpacetimeDb::bsatn::serialize(writer, row);
+        ASSERT_EQ(encoded_size(row), writer.size(), "struct encoded_size matches serialized size");
+    }
+
+    std::cout << "BSATN Encoded Size Tests: SUCCESS" << std::endl;
+}
+
+void test_bsatn_bulk_vectors() {
+    std::cout << "Running BSATN Bulk Vector Tests..." << std::endl;
+    static_assert(SpacetimeDb::bsatn::is_bulk_copyable_v<uint32_t>, "u32 vectors are copied in bulk");
+    static_assert(!SpacetimeDb::bsatn::is_bulk_copyable_v<bool>, "bool vectors are validated per element");
+
+    std::vector<uint32_t> u32s = {0, 1, 0xDEADBEEF, 0xFFFFFFFF};
+    std::vector<int16_t> i16s = {-1, 0, 32767, -32768};
+    std::vector<double> f64s = {0.0, -1.5, 3.141592653589793};
+    std::vector<uint64_t> empty;
+    bsatn::Writer writer;
+    writer.write_vector(u32s);
+    writer.write_vector(i16s);
+    writer.write_vector(f64s);
+    writer.write_vector(empty);
+    ASSERT_EQ(writer.size(), (4 + 4 * 4) + (4 + 4 * 2) + (4 + 3 * 8) + 4, "Bulk vectors have the element-wise wire size");
+
+    // Same bytes as writing the elements one by one.
+    bsatn::Writer element_writer;
+    element_writer.write_u32_le(static_cast<uint32_t>(u32s.size()));
+    for (uint32_t v : u32s) element_writer.write_u32_le(v);
+    ASSERT_TRUE(std::equal(element_writer.view().begin(), element_writer.view().end(), writer.view().begin()),
+                "Bulk u32 vector matches element-wise encoding");
+
+    bsatn::Reader reader(writer.view());
+    ASSERT_TRUE(reader.read_vector<uint32_t>() == u32s, "u32 vector round trip");
+    ASSERT_TRUE(reader.read_vector<int16_t>() == i16s, "i16 vector round trip");
+    ASSERT_TRUE(reader.read_vector<double>() == f64s, "f64 vector round trip");
+    ASSERT_TRUE(reader.read_vector<uint64_t>().empty(), "empty vector round trip");
+    ASSERT_TRUE(reader.is_eos(), "Reader EOS after bulk vectors");
+
+    // A count that promises more elements than the buffer holds fails before any copy.
+    bsatn::Writer short_writer;
+    short_writer.write_u32_le(3);
+    short_writer.write_u32_le(1);
+    bsatn::Reader short_reader(short_writer.view());
+    try { short_reader.read_vector<uint32_t>(); ASSERT_TRUE(false, "Should have thrown on truncated bulk vector"); }
+    catch (const std::out_of_range&) { /* Expected */ }
+
+    std::cout << "BSATN Bulk Vector Tests: SUCCESS" << std::endl;
+}
+
+void test_bsatn_unchecked_reads() {
+    std::cout << "Running BSATN Unchecked Read Tests..." << std::endl;
+    bsatn::Writer writer;
+    writer.write_u32_le(7);
+    writer.write_f64_le(-2.5);
+    writer.write_bool(true);
+    writer.write_i128_le(SpacetimeDb::Types::int128_t_placeholder{0x1122334455667788ULL, -1});
+
+    // One bounds check for the whole fixed-size record, then unchecked loads.
+    bsatn::Reader reader(writer.view());
+    reader.ensure_bytes(4 + 8 + 1 + 16);
+    ASSERT_EQ(reader.read_unchecked<uint32_t>(), 7, "Unchecked u32");
+    ASSERT_EQ(reader.read_unchecked<double>(), -2.5, "Unchecked f64");
+    ASSERT_TRUE(reader.read_unchecked<bool>(), "Unchecked bool");
+    auto i128 = reader.read_unchecked<SpacetimeDb::Types::int128_t_placeholder>();
+    ASSERT_EQ(i128.low, 0x1122334455667788ULL, "Unchecked i128 low");
+    ASSERT_EQ(i128.high, -1, "Unchecked i128 high");
+    ASSERT_TRUE(reader.is_eos(), "Reader EOS after unchecked reads");
+
+    bsatn::Reader short_reader(writer.view().first(12));
+    try { short_reader.ensure_bytes(13); ASSERT_TRUE(false, "Should have thrown on short record"); }
+    catch (const std::out_of_range&) { /* Expected */ }
+    ASSERT_EQ(short_reader.remaining_bytes(), 12, "Failed ensure_bytes consumes nothing");
+
+    // Unchecked bool reads still reject values other than 0 and 1.
+    std::vector<std::byte> bad_bool = {std::byte{2}};
+    bsatn::Reader bool_reader(bad_bool);
+    bool_reader.ensure_bytes(1);
+    try { bool_reader.read_unchecked<bool>(); ASSERT_TRUE(false, "Should have thrown on invalid bool"); }
+    catch (const std::runtime_error&) { /* Expected */ }
+
+    std::cout << "BSATN Unchecked Read Tests: SUCCESS" << std::endl;
+}
+
+void test_bsatn_status_mode() {
+    std::cout << "Running BSATN Status Mode Tests..." << std::endl;
+    using SpacetimeDb::bsatn::DecodeError;
+    using SpacetimeDb::bsatn::ErrorMode;
+
+    std::vector<std::byte> short_buffer = {std::byte{1}};
+    bsatn::Reader short_reader(short_buffer, ErrorMode::Status);
+    ASSERT_EQ(short_reader.read_u32_le(), 0, "Failed read returns a default value");
+    ASSERT_TRUE(short_reader.error() == DecodeError::UnexpectedEnd, "Truncated input is reported");
+    ASSERT_EQ(short_reader.read_u8(), 1, "Failed read consumes nothing");
+
+    bsatn::Writer writer;
+    writer.write_u32_le(2);
+    writer.write_u8(1);
+    writer.write_u8(7); // Not a valid bool.
+    bsatn::Reader bool_reader(writer.view(), ErrorMode::Status);
+    ASSERT_TRUE(bool_reader.read_vector<bool>().empty(), "Vector with a bad element decodes to empty");
+    ASSERT_TRUE(bool_reader.error() == DecodeError::InvalidBool, "Invalid bool is reported");
+
+    std::vector<std::byte> bad_tag = {std::byte{5}};
+    auto optional_result = SpacetimeDb::bsatn::try_deserialize<std::optional<uint8_t>>(bad_tag);
+    ASSERT_FALSE(optional_result.ok(), "Invalid optional tag fails");
+    ASSERT_TRUE(optional_result.error == DecodeError::InvalidTag, "Invalid optional tag is reported");
+
+    bsatn::Writer long_writer;
+    long_writer.write_u32_le(0xFFFFFFFF);
+    auto string_result = SpacetimeDb::bsatn::try_deserialize<std::string_view>(long_writer.view());
+    ASSERT_TRUE(string_result.error == DecodeError::LengthLimit, "Oversized length is reported");
+
+    // try_deserialize on a throwing Reader restores its mode.
+    bsatn::Writer ok_writer;
+    ok_writer.write_u16_le(513);
+    bsatn::Reader reader(ok_writer.view());
+    auto u16_result = SpacetimeDb::bsatn::try_deserialize<uint16_t>(reader);
+    ASSERT_TRUE(u16_result.ok() && u16_result.value == 513, "try_deserialize decodes valid input");
+    ASSERT_TRUE(reader.error_mode() == ErrorMode::Throw, "try_deserialize restores the error mode");
+    try { reader.read_u8(); ASSERT_TRUE(false, "Should have thrown after the mode was restored"); }
+    catch (const std::out_of_range&) { /* Expected */ }
+
+    // Reducer arguments decode left to right.
+    bsatn::Writer args_writer;
+    args_writer.write_u8(1);
+    args_writer.write_u32_le(2);
+    args_writer.write_u8(3);
+    bsatn::Reader args_reader(args_writer.view(), ErrorMode::Status);
+    spacetimedb::sdk::Database db;
+    spacetimedb::sdk::ReducerContext ctx(spacetimedb::sdk::Identity{}, spacetimedb::sdk::Timestamp{}, db);
+    std::tuple<uint8_t, uint32_t, uint8_t> args{};
+    auto record_args = [&](uint8_t a, uint32_t b, uint8_t c) { args = {a, b, c}; };
+    auto args_result = SpacetimeDb::Internal::decode_and_call(record_args, ctx, args_reader,
+                                                              SpacetimeDb::Internal::reducer_args<uint8_t, uint32_t, uint8_t>{});
+    ASSERT_TRUE(args_result && args_reader.ok() && args_reader.is_eos(), "Arguments decode");
+    ASSERT_TRUE(args == std::make_tuple(uint8_t{1}, uint32_t{2}, uint8_t{3}), "Arguments decode in order");
+
+    // Malformed arguments are reported through the reader and the reducer is not called.
+    bsatn::Reader short_args_reader(args_writer.view().first(3), ErrorMode::Status);
+    bool called = false;
+    auto record_call = [&](uint8_t, uint32_t, uint8_t) { called = true; };
+    (void)SpacetimeDb::Internal::decode_and_call(record_call, ctx, short_args_reader,
+                                                 SpacetimeDb::Internal::reducer_args<uint8_t, uint32_t, uint8_t>{});
+    ASSERT_TRUE(!short_args_reader.ok() && !called, "A reducer with malformed arguments is not called");
+
+    std::cout << "BSATN Status Mode Tests: SUCCESS" << std::endl;
+}
+
+void test_bsatn_skip_and_projection() {
+    std::cout << "Running BSATN Skip and Projection Tests..." << std::endl;
+    using namespace SpacetimeDB::Test;
+
+    ComplexType complex_orig;
+    complex_orig.id_field = 4242ULL;
+    complex_orig.string_field = "not materialized";
+    complex_orig.opt_nested_field = NestedData{7, "nested", true};
+    complex_orig.vec_u8_field = {1, 2, 3};
+    complex_orig.vec_string_field = {"skipped", "strings"};
+    complex_orig.vec_opt_i32_field = {std::nullopt, 5};
+    bsatn::Writer writer;
+    SpacetimeDb::bsatn::serialize(writer, complex_orig);
+    SpacetimeDb::bsatn::serialize(writer, complex_orig);
+
+    // skip<T> consumes exactly one encoded value.
+    bsatn::Reader skip_reader(writer.view());
+    SpacetimeDb::bsatn::skip<ComplexType>(skip_reader);
+    ASSERT_EQ(skip_reader.remaining_bytes(), writer.size() / 2, "skip<T> consumes one value");
+    SpacetimeDb::bsatn::skip<ComplexType>(skip_reader);
+    ASSERT_TRUE(skip_reader.is_eos(), "skip<T> consumes the second value");
+
+    auto mask = SpacetimeDb::bsatn::field_mask<ComplexType>({"id_field", "vec_u8_field"});
+    bsatn::Reader reader(writer.view());
+    ComplexType projected = SpacetimeDb::bsatn::deserialize_projected<ComplexType>(reader, mask);
+    ASSERT_EQ(projected.id_field, complex_orig.id_field, "Selected scalar field decoded");
+    ASSERT_TRUE(projected.vec_u8_field == complex_orig.vec_u8_field, "Selected vector field decoded");
+    ASSERT_TRUE(projected.string_field.empty(), "Unselected string left empty");
+    ASSERT_TRUE(!projected.opt_nested_field.has_value(), "Unselected optional left empty");
+    ASSERT_TRUE(projected.vec_string_field.empty(), "Unselected vector left empty");
+    ASSERT_EQ(reader.remaining_bytes(), writer.size() / 2, "Projection consumes the whole value");
+
+    // Optional and vector-of-optional fields, selected and skipped.
+    auto optional_mask = SpacetimeDb::bsatn::field_mask<ComplexType>({"opt_nested_field", "vec_opt_i32_field"});
+    bsatn::Reader optional_reader(writer.view());
+    ComplexType optional_projected = SpacetimeDb::bsatn::deserialize_projected<ComplexType>(optional_reader, optional_mask);
+    ASSERT_TRUE(optional_projected.opt_nested_field == complex_orig.opt_nested_field, "Selected optional struct decoded");
+    ASSERT_TRUE(optional_projected.vec_opt_i32_field == complex_orig.vec_opt_i32_field, "Selected vector of optionals decoded");
+    ASSERT_EQ(optional_projected.id_field, 0u, "Unselected scalar left zero");
+    ASSERT_TRUE(optional_projected.vec_u8_field.empty(), "Unselected bytes left empty");
+    ASSERT_EQ(optional_reader.remaining_bytes(), writer.size() / 2, "Projection of optionals consumes the whole value");
+
+    // deserialize_field_at decodes the single field at a position, as applied to generated columns.
+    bsatn::Writer field_writer;
+    field_writer.write_optional(std::optional<int32_t>(-3));
+    field_writer.write_vector(std::vector<BasicEnum>{BasicEnum::ValTwo, BasicEnum::ValOne});
+    bsatn::Reader field_reader(field_writer.view());
+    ComplexType field_target;
+    SpacetimeDb::bsatn::deserialize_field_at(field_reader, field_target, SpacetimeDb::bsatn::field_index<ComplexType>("opt_i32_field"));
+    SpacetimeDb::bsatn::deserialize_field_at(field_reader, field_target, SpacetimeDb::bsatn::field_index<ComplexType>("vec_enum_field"));
+    ASSERT_TRUE(field_target.opt_i32_field == std::optional<int32_t>(-3), "Optional field decoded by position");
+    ASSERT_TRUE(field_target.vec_enum_field == (std::vector<BasicEnum>{BasicEnum::ValTwo, BasicEnum::ValOne}), "Vector field decoded by position");
+    ASSERT_TRUE(field_reader.is_eos(), "Each positional decode consumes one field");
+
+    // Structs are skipped field by field inside containers too.
+    bsatn::Writer vector_writer;
+    vector_writer.write_vector(std::vector<ComplexType>{complex_orig, complex_orig});
+    vector_writer.write_u8(0xAB);
+    bsatn::Reader vector_reader(vector_writer.view());
+    SpacetimeDb::bsatn::skip<std::vector<ComplexType>>(vector_reader);
+    ASSERT_EQ(vector_reader.read_u8(), 0xAB, "skip of a struct vector stays aligned");
+
+    try { SpacetimeDb::bsatn::field_mask<ComplexType>({"no_such_field"}); ASSERT_TRUE(false, "Should have thrown on unknown field"); }
+    catch (const std::runtime_error&) { /* Expected */ }
+
+    std::cout << "BSATN Skip and Projection Tests: SUCCESS" << std::endl;
+}
+
+void test_bsatn_wide_integers() {
+    std::cout << "Running BSATN Wide Integer Tests..." << std::endl;
+    using SpacetimeDb::Types::u128;
+    using SpacetimeDb::Types::i128;
+    using SpacetimeDb::Types::u256;
+    using SpacetimeDb::Types::i256;
+
+    u128 big = u128::from_parts(1, 0) * 3 + 7; // 3 * 2^64 + 7
+    ASSERT_EQ(big.high(), 3, "u128 high limb");
+    ASSERT_EQ(big.low(), 7, "u128 low limb");
+    ASSERT_EQ((big / 3).high(), 1, "u128 division");
+    ASSERT_TRUE(u128(0) - 1 > big, "u128 wraps like an unsigned integer");
+    ASSERT_EQ(i128(-5).to_string(), "-5", "i128 to_string");
+    ASSERT_TRUE(i128(-1) < i128(0), "i128 signed comparison");
+    ASSERT_EQ((i128(-1) >> 100).to_string(), "-1", "i128 arithmetic shift");
+
+    u256 max = u256(0) - u256(1);
+    ASSERT_EQ(max.to_string(), "115792089237316195423570985008687907853269984665640564039457584007913129639935", "u256 max to_string");
+    ASSERT_TRUE(max / u256(big) * u256(big) + max % u256(big) == max, "u256 division identity");
+    ASSERT_TRUE((u256(1) << 200) >> 199 == u256(2), "u256 shifts across limbs");
+    ASSERT_TRUE(i256(-7) / i256(2) == i256(-3), "i256 division truncates toward zero");
+    ASSERT_TRUE(i256(-7) % i256(2) == i256(-1), "i256 remainder takes the dividend's sign");
+    ASSERT_TRUE(i256(-1) < i256(1) && u256(max) > u256(1), "u256 / i256 comparison");
+    ASSERT_TRUE(std::hash<u256>{}(u256(42)) == std::hash<u256>{}(u256(42)), "u256 hash is deterministic");
+    ASSERT_TRUE(std::hash<u128>{}(big) != std::hash<u128>{}(big + 1), "u128 hash distinguishes values");
+
+    // The wire format is the little-endian two's complement bytes, written and read in one copy.
+    bsatn::Writer writer;
+    SpacetimeDb::bsatn::serialize(writer, big);
+    SpacetimeDb::bsatn::serialize(writer, i128(-2));
+    SpacetimeDb::bsatn::serialize(writer, max);
+    SpacetimeDb::bsatn::serialize(writer, i256(-3));
+    writer.write_vector(std::vector<u128>{1, 2});
+    ASSERT_EQ(writer.size(), 16 + 16 + 32 + 32 + (4 + 2 * 16), "Wide integer wire sizes");
+    ASSERT_EQ(static_cast<uint8_t>(writer.view()[0]), 7, "u128 low byte first");
+    ASSERT_EQ(static_cast<uint8_t>(writer.view()[8]), 3, "u128 high limb after the low limb");
+    ASSERT_EQ(SpacetimeDb::bsatn::encoded_size<i256>(), 32, "i256 is fixed-size");
+
+    bsatn::Reader reader(writer.view());
+    ASSERT_TRUE(SpacetimeDb::bsatn::deserialize<u128>(reader) == big, "u128 round trip");
+    ASSERT_TRUE(SpacetimeDb::bsatn::deserialize<i128>(reader) == i128(-2), "i128 round trip");
+    ASSERT_TRUE(SpacetimeDb::bsatn::deserialize<u256>(reader) == max, "u256 round trip");
+    ASSERT_TRUE(SpacetimeDb::bsatn::deserialize<i256>(reader) == i256(-3), "i256 round trip");
+    ASSERT_TRUE((reader.read_vector<u128>() == std::vector<u128>{1, 2}), "u128 vector round trip");
+    ASSERT_TRUE(reader.is_eos(), "Reader EOS after wide integers");
+
+    // As an index key: `[key, key]` with the key in its BSATN form.
+    auto range = spacetimedb::sdk::encode_index_eq(std::make_tuple(big));
+    ASSERT_EQ(range.start_len(), 1 + 16, "u128 key bound is tag + 16 bytes");
+    ASSERT_EQ(range.start_ptr()[1], 7, "u128 key bound holds the key bytes");
+
+    std::cout << "BSATN Wide Integer Tests: SUCCESS" << std::endl;
+}
+
+void test_bsatn_bitwise_layout() {
+    std::cout << "Running BSATN Bitwise Layout Tests..." << std::endl;
+    using SpacetimeDB::Test::BitwisePosition;
+    static_assert(SpacetimeDb::bsatn::is_bitwise_layout<BitwisePosition>::value, "Unpadded POD row is bitwise");
+    static_assert(SpacetimeDb::bsatn::is_bulk_copyable_v<BitwisePosition>, "Vectors of bitwise rows are copied in bulk");
+
+    BitwisePosition pos{7, 1.0f, -2.0f, 3.5f};
+    bsatn::Writer writer;
+    SpacetimeDb::bsatn::serialize(writer, pos);
+    writer.write_vector(std::vector<BitwisePosition>{pos, {8, 0.0f, 0.0f, 1.0f}});
+
+    // Same bytes as writing the fields one by one.
+    bsatn::Writer field_writer;
+    field_writer.write_u32_le(7);
+    field_writer.write_f32_le(1.0f);
+    field_writer.write_f32_le(-2.0f);
+    field_writer.write_f32_le(3.5f);
+    ASSERT_EQ(writer.size(), 16 + 4 + 2 * 16, "Bitwise rows have the field-wise wire size");
+    ASSERT_TRUE(std::equal(field_writer.view().begin(), field_writer.view().end(), writer.view().begin()),
+                "Bitwise row matches field-wise encoding");
+
+    bsatn::Reader reader(writer.view());
+    BitwisePosition decoded = SpacetimeDb::bsatn::deserialize<BitwisePosition>(reader);
+    ASSERT_TRUE(decoded.id == 7 && decoded.x == 1.0f && decoded.y == -2.0f && decoded.z == 3.5f, "Bitwise row round trip");
+    auto decoded_vec = SpacetimeDb::bsatn::deserialize<std::vector<BitwisePosition>>(reader);
+    ASSERT_TRUE(decoded_vec.size() == 2 && decoded_vec[1].id == 8 && decoded_vec[1].z == 1.0f, "Bitwise vector round trip");
+    ASSERT_TRUE(reader.is_eos(), "Reader EOS after bitwise rows");
+
+    bsatn::Reader short_reader(writer.view().first(10), SpacetimeDb::bsatn::ErrorMode::Status);
+    (void)SpacetimeDb::bsatn::deserialize<BitwisePosition>(short_reader);
+    ASSERT_TRUE(short_reader.error() == SpacetimeDb::bsatn::DecodeError::UnexpectedEnd, "Short bitwise row is rejected");
+
+    std::cout << "BSATN Bitwise Layout Tests: SUCCESS" << std::endl;
+}
+
+// Every member of Table<T> must compile for a macro-registered row type.
+template class spacetimedb::sdk::Table<SpacetimeDB::Test::BitwisePosition>;
+
+void test_table_row_concepts() {
+    std::cout << "Running Table Row Concept Tests..." << std::endl;
+    using SpacetimeDB::Test::BitwisePosition;
+    struct NoCodec { int x; };
+    static_assert(SpacetimeDb::bsatn::Codec<BitwisePosition>, "Macro-registered rows round-trip");
+    static_assert(SpacetimeDb::bsatn::Codec<std::string> && SpacetimeDb::bsatn::Codec<std::vector<uint32_t>>);
+    static_assert(SpacetimeDb::bsatn::Serializable<std::optional<BitwisePosition>>);
+    static_assert(!SpacetimeDb::bsatn::Serializable<NoCodec>, "Structs without a codec are rejected");
+    static_assert(!SpacetimeDb::bsatn::Serializable<const char*>, "Pointers are rejected");
+
+    spacetimedb::sdk::Table<BitwisePosition> table(7);
+    (void)table;
+
+    std::cout << "Table Row Concept Tests: SUCCESS" << std::endl;
+}
+
+void test_bsatn_streaming_reader() {
+    std::cout << "Running BSATN Streaming Reader Tests..." << std::endl;
+    using SpacetimeDb::bsatn::StreamingReader;
+
+    std::vector<uint32_t> big_vec(1000);
+    std::iota(big_vec.begin(), big_vec.end(), 0u);
+    std::string long_string(300, 'x');
+    bsatn::Writer writer;
+    writer.write_u64_le(0x0102030405060708ULL);
+    writer.write_string(long_string);               // Longer than one chunk.
+    writer.write_vector(big_vec);                   // Copied chunk by chunk.
+    writer.write_bytes(std::vector<std::byte>(500)); // Skipped without buffering.
+    writer.write_u8(1);                             // Some(-9) as an optional<i32>.
+    writer.write_i32_le(-9);
+    std::span<const std::byte> input = writer.view();
+
+    // Hands out at most 7 bytes per pull, like a host returning short reads.
+    size_t offset = 0;
+    size_t pulls = 0;
+    auto pull = [&](std::span<std::byte> dest) -> size_t {
+        size_t n = std::min({dest.size(), input.size() - offset, size_t{7}});
+        std::copy_n(input.begin() + offset, n, dest.begin());
+        offset += n;
+        ++pulls;
+        return n;
+    };
+
+    StreamingReader reader(pull, SpacetimeDb::bsatn::ErrorMode::Throw, 64);
+    ASSERT_EQ(reader.read_u64_le(), 0x0102030405060708ULL, "Streamed u64");
+    ASSERT_EQ(reader.read_string(), long_string, "Streamed string longer than a chunk");
+    ASSERT_TRUE(reader.read_vector<uint32_t>() == big_vec, "Streamed bulk vector");
+    reader.skip_bytes(4 + 500);
+    ASSERT_TRUE(reader.read_optional<int32_t>() == std::optional<int32_t>(-9), "Streamed optional");
+    ASSERT_TRUE(reader.is_eos(), "Streaming reader reaches the end of the source");
+    ASSERT_TRUE(pulls > input.size() / 7, "Input was pulled in pieces");
+
+    // Running out of input mid-value is UnexpectedEnd, as with a plain Reader.
+    offset = input.size() - 3;
+    StreamingReader short_reader(pull, SpacetimeDb::bsatn::ErrorMode::Status, 64);
+    (void)short_reader.read_u32_le();
+    ASSERT_TRUE(short_reader.error() == SpacetimeDb::bsatn::DecodeError::UnexpectedEnd, "Truncated stream is rejected");
+
+    std::cout << "BSATN Streaming Reader Tests: SUCCESS" << std::endl;
+}
+
+void test_bsatn_sink_writer() {
+    std::cout << "Running BSATN Sink Writer Tests..." << std::endl;
+    using SpacetimeDb::bsatn::SinkWriter;
+
+    std::vector<std::byte> received;
+    std::vector<size_t> chunk_sizes;
+    auto push = [&](std::span<const std::byte> bytes) {
+        received.insert(received.end(), bytes.begin(), bytes.end());
+        chunk_sizes.push_back(bytes.size());
+    };
+
+    std::vector<uint64_t> large(100, 0xABCDEF); // 800 bytes: larger than the buffer.
+    bsatn::Writer expected;
+    {
+        SinkWriter writer(push, 64);
+        for (uint32_t i = 0; i < 40; ++i) {
+            writer.write_u32_le(i);
+            expected.write_u32_le(i);
+        }
+        writer.write_string("spans a flush");
+        expected.write_string("spans a flush");
+        writer.write_vector(large);
+        expected.write_vector(large);
+        writer.write_u8(7);
+        expected.write_u8(7);
+        ASSERT_TRUE(writer.size() <= 64, "Only the unflushed tail is buffered");
+        ASSERT_EQ(writer.total_size(), expected.size(), "total_size counts pushed bytes");
+        writer.flush();
+        ASSERT_EQ(writer.size(), 0, "flush() empties the buffer");
+    }
+    ASSERT_TRUE(received == expected.get_buffer(), "Pushed chunks concatenate to the full output");
+    ASSERT_TRUE(std::find(chunk_sizes.begin(), chunk_sizes.end(), large.size() * sizeof(uint64_t)) != chunk_sizes.end(),
+                "A write larger than the buffer is pushed directly");
+
+    // The destructor pushes whatever is left.
+    received.clear();
+    {
+        SinkWriter writer(push, 64);
+        writer.write_u16_le(0x0102);
+    }
+    ASSERT_EQ(received.size(), 2, "Destructor flushes the tail");
+
+    std::cout << "BSATN Sink Writer Tests: SUCCESS" << std::endl;
+}
+
+void test_reducer_context_from_scalars() {
+    std::cout << "Running Reducer Context Tests..." << std::endl;
+
+    // The argument bytes hold only the reducer's own argument; sender, connection id and
+    // timestamp come from the scalar parameters.
+    bsatn::Writer writer;
+    writer.write_u32_le(77);
+    std::vector<std::byte> args = writer.take_buffer();
+    BytesSource source = _bytes_source_create_from_bytes(reinterpret_cast<const uint8_t*>(args.data()), args.size());
+    BytesSink err_sink = _bytes_sink_create();
+
+    uint32_t reducer_id = SpacetimeDb::ModuleSchema::instance().reducer_id("ContextReducerUnit");
+    ASSERT_NE(reducer_id, UINT32_MAX, "ContextReducerUnit ID not found");
+    g_context_reducer_log.clear();
+    int16_t status = __call_reducer__(reducer_id, 0x11, 0, 0, 0xAB00000000000000ULL, 5, 1,
+                                      1700000000123456ULL, source, err_sink);
+    ASSERT_EQ(status, 0, "ContextReducerUnit dispatch status OK");
+    // Identity words are little-endian: byte 0 is the low byte of p0, byte 31 the high byte of p3.
+    // The connection id is p0 | p1 << 64.
+    ASSERT_EQ(g_context_reducer_log, "17,171,18446744073709551621,1700000000123456,77", "Context built from scalars");
+    _bytes_source_done(source);
+    _bytes_sink_done(err_sink);
+
+    std::cout << "Reducer Context Tests: SUCCESS" << std::endl;
+}
+
+void test_reducer_borrowed_args() {
+    std::cout << "Running Borrowed Reducer Argument Tests..." << std::endl;
+    using SpacetimeDb::bsatn::is_borrowed_v;
+    static_assert(is_borrowed_v<std::string_view> && is_borrowed_v<const std::span<const std::byte>&>);
+    static_assert(is_borrowed_v<std::optional<std::vector<std::string_view>>>);
+    static_assert(!is_borrowed_v<std::string> && !is_borrowed_v<SpacetimeDB::Test::BitwisePosition>);
+
+    auto& schema = SpacetimeDb::ModuleSchema::instance();
+    uint32_t reducer_id = schema.reducer_id("BorrowedArgsReducerUnit");
+    ASSERT_NE(reducer_id, UINT32_MAX, "BorrowedArgsReducerUnit ID not found");
+    ASSERT_TRUE(schema.reducer_by_id(reducer_id)->borrows_args, "View parameters mark the reducer as borrowing");
+    ASSERT_TRUE(!schema.reducer_by_id(schema.reducer_id("SimpleReducerUnit"))->borrows_args, "Owned parameters do not");
+
+    // Large enough that an owning reducer's arguments would be streamed; views need the whole buffer.
+    std::vector<std::byte> blob(200 * 1024, std::byte{0});
+    blob.back() = std::byte{42};
+    bsatn::Writer writer;
+    writer.write_string("borrowed_key");
+    writer.write_bytes(blob);
+    std::vector<std::byte> args = writer.take_buffer();
+    BytesSource source = _bytes_source_create_from_bytes(reinterpret_cast<const uint8_t*>(args.data()), args.size());
+    BytesSink err_sink = _bytes_sink_create();
+
+    g_borrowed_reducer_log.clear();
+    int16_t status = __call_reducer__(reducer_id, 0,0,0,0,0,0,0, source, err_sink);
+    ASSERT_EQ(status, 0, "BorrowedArgsReducerUnit dispatch status OK");
+    ASSERT_EQ(g_borrowed_reducer_log, "borrowed_key,204800,42", "Views cover the whole argument");
+    _bytes_source_done(source);
+    _bytes_sink_done(err_sink);
+
+    std::cout << "Borrowed Reducer Argument Tests: SUCCESS" << std::endl;
+}
+
+void test_reducer_arena() {
+    std::cout << "Running Reducer Arena Tests..." << std::endl;
+    using spacetimedb::sdk::ReducerArena;
+
+    ReducerArena arena(256, 1024);
+    void* first = arena.allocate(10, 1);
+    void* aligned = arena.allocate(100, 64);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(aligned) % 64, 0, "Allocations honour alignment");
+    void* large = arena.allocate(4096, 16);
+    ASSERT_TRUE(large != nullptr && arena.capacity() > 4096, "Large allocations get a chunk of their own");
+    arena.reset();
+    ASSERT_EQ(arena.capacity(), 256, "Chunks past the retained size are freed on reset");
+    ASSERT_TRUE(arena.allocate(10, 1) == first, "Reset rewinds to the start");
+
+    // Chunks within the retained size are reused by later calls.
+    arena.reset();
+    void* a = arena.allocate(200, 8);
+    void* b = arena.allocate(200, 8);
+    size_t capacity = arena.capacity();
+    arena.reset();
+    ASSERT_TRUE(arena.allocate(200, 8) == a && arena.allocate(200, 8) == b, "Same allocations, same addresses");
+    ASSERT_EQ(arena.capacity(), capacity, "No new chunks on the second call");
+
+    // __call_reducer__ makes the reducer arena current for the call only.
+    ASSERT_TRUE(&spacetimedb::sdk::current_memory_resource() == std::pmr::get_default_resource(),
+                "Outside a call, the default resource is current");
+    ASSERT_TRUE(g_context_reducer_saw_arena, "ctx.arena() is the reducer arena during a call");
+
+    std::cout << "Reducer Arena Tests: SUCCESS" << std::endl;
+}
+
+void test_reducer_result_errors() {
+    std::cout << "Running Reducer Result Tests..." << std::endl;
+    using spacetimedb::sdk::Error;
+    using spacetimedb::sdk::Result;
+
+    Result<int> found(7);
+    ASSERT_TRUE(found.ok() && found.value() == 7, "Result holds its value");
+    Result<int> missing(Error{"no row", 2});
+    ASSERT_TRUE(!missing && missing.error().code == 2, "Result holds its error and host code");
+    ASSERT_TRUE(spacetimedb::sdk::ReducerResult().ok(), "A default ReducerResult is success");
+
+    auto& schema = SpacetimeDb::ModuleSchema::instance();
+    uint32_t reducer_id = schema.reducer_id("ResultReducerUnit");
+    ASSERT_NE(reducer_id, UINT32_MAX, "ResultReducerUnit ID not found");
+
+    auto call_with = [&](uint32_t amount, std::string& error_out) {
+        bsatn::Writer writer;
+        writer.write_u32_le(amount);
+        std::vector<std::byte> args = writer.take_buffer();
+        BytesSource source = _bytes_source_create_from_bytes(reinterpret_cast<const uint8_t*>(args.data()), args.size());
+        BytesSink err_sink = _bytes_sink_create();
+        int16_t status = __call_reducer__(reducer_id, 0,0,0,0,0,0,0, source, err_sink);
+        const auto& written = g_mock_sinks_data[err_sink.inner];
+        error_out.assign(reinterpret_cast<const char*>(written.data()), written.size());
+        _bytes_source_done(source);
+        _bytes_sink_done(err_sink);
+        return status;
+    };
+
+    std::string error_message;
+    ASSERT_EQ(call_with(5, error_message), 0, "A successful ReducerResult reports OK");
+    ASSERT_TRUE(error_message.empty(), "Nothing written to the error sink on success");
+    // A failed result is a failed call (HOST_CALL_FAILURE) with the message in the error sink.
+    ASSERT_EQ(call_with(0, error_message), 1, "A failed ReducerResult fails the call");
+    ASSERT_EQ(error_message, "amount must be positive", "The error message reaches the host");
+
+    std::cout << "Reducer Result Tests: SUCCESS" << std::endl;
+}
+
+void test_reducer_batch() {
+    std::cout << "Running Batch Reducer Tests..." << std::endl;
+    auto& schema = SpacetimeDb::ModuleSchema::instance();
+    uint32_t batch_id = schema.reducer_id("BatchReducerUnit");
+    uint32_t result_id = schema.reducer_id("ResultReducerUnit");
+    ASSERT_NE(batch_id, UINT32_MAX, "BatchReducerUnit ID not found");
+    ASSERT_TRUE(schema.reducers["BatchReducerUnit"].parameters[0].is_array, "The batch takes a Vec<BatchCall>");
+
+    // Vec<(reducer_id, args)> with each entry's arguments as BSATN bytes.
+    auto call_batch = [&](const std::vector<std::pair<uint32_t, uint32_t>>& calls, std::string& error_out) {
+        bsatn::Writer writer;
+        writer.write_u32_le(static_cast<uint32_t>(calls.size()));
+        for (const auto& [reducer_id, amount] : calls) {
+            bsatn::Writer entry_args;
+            entry_args.write_u32_le(amount);
+            writer.write_u32_le(reducer_id);
+            writer.write_bytes(entry_args.take_buffer());
+        }
+        std::vector<std::byte> args = writer.take_buffer();
+        BytesSource source = _bytes_source_create_from_bytes(reinterpret_cast<const uint8_t*>(args.data()), args.size());
+        BytesSink err_sink = _bytes_sink_create();
+        int16_t status = __call_reducer__(batch_id, 0,0,0,0,0,0,0, source, err_sink);
+        const auto& written = g_mock_sinks_data[err_sink.inner];
+        error_out.assign(reinterpret_cast<const char*>(written.data()), written.size());
+        _bytes_source_done(source);
+        _bytes_sink_done(err_sink);
+        return status;
+    };
+
+    std::string error_message;
+    g_reducer_call_log_test.clear();
+    ASSERT_EQ(call_batch({{result_id, 1}, {result_id, 2}}, error_message), 0, "Batch of successful calls reports OK");
+    ASSERT_EQ(g_reducer_call_log_test.size(), 2, "Each entry is dispatched in order");
+    ASSERT_EQ(g_reducer_call_log_test[1], "test_reducer_result_impl_unit called with: 2", "Entry arguments decoded");
+
+    // The first failing entry fails the whole batch, so its transaction is rolled back.
+    g_reducer_call_log_test.clear();
+    ASSERT_EQ(call_batch({{result_id, 1}, {result_id, 0}, {result_id, 3}}, error_message), 1, "A failing entry fails the batch");
+    ASSERT_EQ(error_message, "batch[1] ResultReducerUnit: amount must be positive", "Error names the entry and reducer");
+    ASSERT_EQ(g_reducer_call_log_test.size(), 1, "Entries after the failure are not run");
+
+    ASSERT_EQ(call_batch({{UINT32_MAX - 1, 1}}, error_message), 1, "Unknown reducer IDs fail the batch");
+    ASSERT_EQ(call_batch({{batch_id, 1}}, error_message), 1, "Batches cannot be nested");
+
+    std::cout << "Batch Reducer Tests: SUCCESS" << std::endl;
+}
+
 void run_all_unit_tests() {
     std::cout << "========== Starting SDK Unit Tests ==========" << std::endl;
     test_bsatn_primitives();
     test_bsatn_error_conditions();
+    test_bsatn_zero_copy_views();
+    test_bsatn_writer_external_buffer();
+    test_bsatn_encoded_size();
+    test_bsatn_bulk_vectors();
+    test_bsatn_unchecked_reads();
+    test_bsatn_status_mode();
+    test_bsatn_skip_and_projection();
+    test_bsatn_wide_integers();
+    test_bsatn_bitwise_layout();
+    test_table_row_concepts();
+    test_bsatn_streaming_reader();
+    test_bsatn_sink_writer();
+    test_reducer_context_from_scalars();
+    test_reducer_borrowed_args();
+    test_reducer_arena();
+    test_reducer_result_errors();
+    test_reducer_batch();
     test_macro_serialization();
     test_reducer_dispatch();
     test_module_def_abi();
+    test_module_def_constraints();
     test_sdk_runtime_wrappers();
+    test_row_iterator_batching();
+    test_index_range_scans();
+    test_index_range_deletes();
+    test_table_row_count();
+    test_table_find_unique();
+    test_database_get_table();
     std::cout << "========== All SDK Unit Tests Passed ==========" << std::endl;
 }
@@ -7,6 +7,7 @@
 #include <vector>
 #include <iomanip> // For print_bytes_test, if added here
 #include <cstddef> // For std::byte
+#include <cstring> // For std::memcpy
 
 // Basic Assertion Macro
 #define ASSERT_CONDITION(condition, message) \
@@ -57,6 +58,85 @@ static std::map<uint16_t, std::vector<std::byte>> g_mock_sources_data;
 static std::map<uint16_t, size_t> g_mock_sources_read_offset;
 
 
+// --- Mock Datastore ---
+// Names the host resolves, keyed like the ModuleDef the tests register (see test_types.h).
+static std::map<std::string, uint32_t> g_mock_table_ids = {
+    {"Counters", 1}, {"TestNestedStructTable", 2}, {"MyNestedTable", 3}, {"AnotherTableUnit", 4},
+    {"PositionsA", 5}, {"PositionsB", 6},
+};
+static std::map<std::string, uint32_t> g_mock_index_ids = {
+    {"MyNestedTable_item_id_idx_btree", 30}, {"AnotherTableUnit_key_idx_btree", 40},
+};
+
+// Arguments of one `datastore_index_scan_range_bsatn` / `datastore_delete_by_index_scan_range_bsatn` call.
+struct MockIndexRangeCall {
+    uint32_t index_id = 0;
+    std::vector<std::byte> prefix;
+    uint16_t prefix_elems = 0;
+    std::vector<std::byte> rstart;
+    std::vector<std::byte> rend;
+};
+static std::vector<MockIndexRangeCall> g_mock_index_scan_calls;
+static std::vector<MockIndexRangeCall> g_mock_index_delete_calls;
+// Rows the next index scan yields, one BSATN row each; the scan opens a row iterator over them.
+static std::vector<std::vector<std::byte>> g_mock_index_scan_rows;
+static uint16_t g_mock_index_scan_status = 0;
+static uint32_t g_mock_index_delete_count = 0;
+static uint16_t g_mock_index_delete_status = 0;
+
+// Rows a full table scan yields, one BSATN row each.
+static std::vector<std::vector<std::byte>> g_mock_table_scan_rows;
+static uint64_t g_mock_row_count = 0;
+static uint16_t g_mock_row_count_status = 0;
+
+// Rows passed to `datastore_insert_bsatn` / `datastore_update_bsatn`, and the index of each update.
+static std::vector<std::vector<std::byte>> g_mock_inserted_rows;
+static std::vector<std::vector<std::byte>> g_mock_updated_rows;
+static std::vector<uint32_t> g_mock_update_index_ids;
+static uint16_t g_mock_update_status = 0;
+// BSATN product of generated sequence values written back by insert/update; empty for none.
+static std::vector<std::byte> g_mock_generated_columns;
+
+inline std::string mock_name_of(const std::map<std::string, uint32_t>& ids, uint32_t id) {
+    for (const auto& [name, known_id] : ids) {
+        if (known_id == id) return name;
+    }
+    return "#" + std::to_string(id);
+}
+
+inline std::vector<std::byte> mock_bytes(const uint8_t* ptr, size_t len) {
+    const std::byte* byte_ptr = reinterpret_cast<const std::byte*>(ptr);
+    return std::vector<std::byte>(byte_ptr, byte_ptr + len);
+}
+
+inline MockIndexRangeCall mock_index_range_call(IndexId index_id, const uint8_t* prefix_ptr, uint32_t prefix_len,
+                                                ColId prefix_elems, const uint8_t* rstart_ptr, uint32_t rstart_len,
+                                                const uint8_t* rend_ptr, uint32_t rend_len) {
+    return MockIndexRangeCall{index_id.inner, mock_bytes(prefix_ptr, prefix_len), prefix_elems.inner,
+                              mock_bytes(rstart_ptr, rstart_len), mock_bytes(rend_ptr, rend_len)};
+}
+
+inline void mock_write_generated_columns(uint8_t* row_ptr, size_t* row_len_ptr) {
+    std::memcpy(row_ptr, g_mock_generated_columns.data(), g_mock_generated_columns.size());
+    *row_len_ptr = g_mock_generated_columns.size();
+}
+
+// Arguments of one legacy `_iter_by_col_eq` call, the rows it matches, and the host buffers.
+struct MockColEqCall {
+    uint32_t table_id = 0;
+    uint32_t col_id = 0;
+    std::vector<std::byte> value;
+};
+static std::vector<MockColEqCall> g_mock_col_eq_calls;
+static std::vector<std::vector<std::byte>> g_mock_col_eq_rows;
+static std::map<uint32_t, std::vector<std::byte>> g_mock_buffers;
+static uint32_t g_mock_next_buffer = 1;
+
+// Defined with the row iterator stubs below.
+static std::map<uint32_t, std::vector<std::vector<std::byte>>> g_mock_row_iters;
+static std::map<uint32_t, size_t> g_mock_row_iters_pos;
+static uint32_t g_mock_next_row_iter = 1000; // Clear of the handles tests pick by hand.
+
 extern "C" {
 
 // --- Logging ---
@@ -78,38 +158,140 @@ void _log_message_abi(::LogLevel level_abi, const uint8_t* message_ptr, uint32_t
 }
 
 // --- Table Operations ---
-// Matches: Status table_insert(const uint8_t* table_name_ptr, uint32_t table_name_len,
-//                             const uint8_t* row_data_ptr, uint32_t row_data_len);
-Status table_insert(const uint8_t* table_name_ptr, uint32_t table_name_len,
-                    const uint8_t* row_data_ptr, uint32_t row_data_len) {
-    std::string table_name(reinterpret_cast<const char*>(table_name_ptr), table_name_len);
-    std::string log_entry = "table_insert Table: " + table_name + ", DataLen: " + std::to_string(row_data_len);
+Status table_id_from_name(const uint8_t* name_ptr, uint32_t name_len, TableId* out_table_id_ptr) {
+    auto it = g_mock_table_ids.find(std::string(reinterpret_cast<const char*>(name_ptr), name_len));
+    if (it == g_mock_table_ids.end()) return {4}; // NO_SUCH_TABLE
+    out_table_id_ptr->inner = it->second;
+    return {0};
+}
+
+Status index_id_from_name(const uint8_t* name_ptr, uint32_t name_len, IndexId* out_index_id_ptr) {
+    auto it = g_mock_index_ids.find(std::string(reinterpret_cast<const char*>(name_ptr), name_len));
+    if (it == g_mock_index_ids.end()) return {5}; // NO_SUCH_INDEX
+    out_index_id_ptr->inner = it->second;
+    return {0};
+}
+
+uint16_t _get_table_id(const uint8_t* name_ptr, size_t name_len, uint32_t* out_table_id_ptr) {
+    TableId table_id{0};
+    Status status = table_id_from_name(name_ptr, static_cast<uint32_t>(name_len), &table_id);
+    *out_table_id_ptr = table_id.inner;
+    return status.inner;
+}
+
+// The row is accepted as is: there are no generated columns to write back in place.
+uint16_t _insert(uint32_t table_id, uint8_t* row_bsatn_ptr, size_t row_bsatn_len) {
+    std::string log_entry = "_insert Table: " + mock_name_of(g_mock_table_ids, table_id) +
+                            ", DataLen: " + std::to_string(row_bsatn_len);
     std::cout << "[HOST STUB] " << log_entry << std::endl;
     g_host_table_ops_log.push_back(log_entry);
-    return {0}; // OK Status
+    g_mock_inserted_rows.push_back(mock_bytes(row_bsatn_ptr, row_bsatn_len));
+    return 0;
+}
+
+Status datastore_table_row_count(TableId table_id, uint64_t* out_count_ptr) {
+    g_host_table_ops_log.push_back("datastore_table_row_count Table: " + mock_name_of(g_mock_table_ids, table_id.inner));
+    if (g_mock_row_count_status != 0) return {g_mock_row_count_status};
+    *out_count_ptr = g_mock_row_count;
+    return {0};
+}
+
+Status datastore_table_scan_bsatn(TableId table_id, RowIter* out_iter_ptr) {
+    g_host_table_ops_log.push_back("datastore_table_scan_bsatn Table: " + mock_name_of(g_mock_table_ids, table_id.inner));
+    uint32_t handle = g_mock_next_row_iter++;
+    g_mock_row_iters[handle] = g_mock_table_scan_rows;
+    g_mock_row_iters_pos[handle] = 0;
+    out_iter_ptr->inner = handle;
+    return {0};
+}
+
+Status datastore_index_scan_range_bsatn(IndexId index_id, const uint8_t* prefix_ptr, uint32_t prefix_len,
+                                        ColId prefix_elems, const uint8_t* rstart_ptr, uint32_t rstart_len,
+                                        const uint8_t* rend_ptr, uint32_t rend_len, RowIter* out_iter_ptr) {
+    g_mock_index_scan_calls.push_back(mock_index_range_call(index_id, prefix_ptr, prefix_len, prefix_elems,
+                                                            rstart_ptr, rstart_len, rend_ptr, rend_len));
+    if (g_mock_index_scan_status != 0) return {g_mock_index_scan_status};
+    uint32_t handle = g_mock_next_row_iter++;
+    g_mock_row_iters[handle] = g_mock_index_scan_rows;
+    g_mock_row_iters_pos[handle] = 0;
+    out_iter_ptr->inner = handle;
+    return {0};
 }
 
-// Matches: Status table_delete_by_pk(const uint8_t* table_name_ptr, uint32_t table_name_len,
-//                                   const uint8_t* pk_data_ptr, uint32_t pk_data_len);
-Status table_delete_by_pk(const uint8_t* table_name_ptr, uint32_t table_name_len,
-                          const uint8_t* pk_data_ptr, uint32_t pk_data_len) {
-    std::string table_name(reinterpret_cast<const char*>(table_name_ptr), table_name_len);
-    std::string log_entry = "table_delete_by_pk Table: " + table_name + ", PKLen: " + std::to_string(pk_data_len);
+Status datastore_delete_by_index_scan_range_bsatn(IndexId index_id, const uint8_t* prefix_ptr, uint32_t prefix_len,
+                                                  ColId prefix_elems, const uint8_t* rstart_ptr, uint32_t rstart_len,
+                                                  const uint8_t* rend_ptr, uint32_t rend_len,
+                                                  uint32_t* out_deleted_count_ptr) {
+    std::string log_entry = "datastore_delete_by_index_scan_range_bsatn Index: " +
+                            mock_name_of(g_mock_index_ids, index_id.inner) + ", PrefixLen: " + std::to_string(prefix_len);
     std::cout << "[HOST STUB] " << log_entry << std::endl;
     g_host_table_ops_log.push_back(log_entry);
-    return {0}; // OK Status
+    g_mock_index_delete_calls.push_back(mock_index_range_call(index_id, prefix_ptr, prefix_len, prefix_elems,
+                                                              rstart_ptr, rstart_len, rend_ptr, rend_len));
+    if (g_mock_index_delete_status != 0) return {g_mock_index_delete_status};
+    *out_deleted_count_ptr = g_mock_index_delete_count;
+    return {0};
+}
+
+Status datastore_insert_bsatn(TableId table_id, uint8_t* row_ptr, size_t* row_len_ptr) {
+    g_host_table_ops_log.push_back("datastore_insert_bsatn Table: " + mock_name_of(g_mock_table_ids, table_id.inner));
+    g_mock_inserted_rows.push_back(mock_bytes(row_ptr, *row_len_ptr));
+    mock_write_generated_columns(row_ptr, row_len_ptr);
+    return {0};
 }
 
-// Minimal stub for _get_table_id if needed by any C++ wrappers under test
-uint16_t _get_table_id(const uint8_t *name_ptr, size_t name_len, uint32_t *out_table_id_ptr) {
-    std::string name(reinterpret_cast<const char*>(name_ptr), name_len);
-    std::cout << "[HOST STUB _get_table_id] Name: " << name << std::endl;
-    if (name == "Counters" || name == "TestNestedStructTable" || name == "AnotherTable" || name == "MyNestedTable") { // Add known test tables
-        if (out_table_id_ptr) *out_table_id_ptr = (name == "Counters" ? 1 : (name == "TestNestedStructTable" ? 2 : 3) ); // Dummy table IDs
-        return 0; // OK status
+Status datastore_update_bsatn(TableId table_id, IndexId index_id, uint8_t* row_ptr, size_t* row_len_ptr) {
+    g_host_table_ops_log.push_back("datastore_update_bsatn Table: " + mock_name_of(g_mock_table_ids, table_id.inner));
+    g_mock_update_index_ids.push_back(index_id.inner);
+    if (g_mock_update_status != 0) return {g_mock_update_status};
+    g_mock_updated_rows.push_back(mock_bytes(row_ptr, *row_len_ptr));
+    mock_write_generated_columns(row_ptr, row_len_ptr);
+    return {0};
+}
+
+// The legacy iterator imports: every iteration is empty.
+uint16_t _iter_start(uint32_t table_id, BufferIter* out_iter_ptr) {
+    g_host_table_ops_log.push_back("_iter_start Table: " + mock_name_of(g_mock_table_ids, table_id));
+    *out_iter_ptr = 1;
+    return 0;
+}
+
+uint16_t _iter_next(BufferIter, Buffer* out_row_data_buf_ptr) {
+    *out_row_data_buf_ptr = 0; // No more rows.
+    return 0;
+}
+
+uint16_t _iter_drop(BufferIter) {
+    return 0;
+}
+
+// The legacy column lookup returns its matches concatenated in a host buffer, or buffer 0 for none.
+uint16_t _iter_by_col_eq(uint32_t table_id, uint32_t col_id, const uint8_t* value_bsatn_ptr, size_t value_bsatn_len,
+                         Buffer* out_buffer_ptr_with_rows) {
+    g_mock_col_eq_calls.push_back(MockColEqCall{table_id, col_id, mock_bytes(value_bsatn_ptr, value_bsatn_len)});
+    if (g_mock_col_eq_rows.empty()) {
+        *out_buffer_ptr_with_rows = 0;
+        return 0;
+    }
+    Buffer handle = g_mock_next_buffer++;
+    for (const auto& row : g_mock_col_eq_rows) {
+        g_mock_buffers[handle].insert(g_mock_buffers[handle].end(), row.begin(), row.end());
     }
-    if (out_table_id_ptr) *out_table_id_ptr = 0; // Indicate not found
-    return 1; // Error status (e.g., not found)
+    *out_buffer_ptr_with_rows = handle;
+    return 0;
+}
+
+size_t _buffer_len(Buffer bufh) {
+    auto it = g_mock_buffers.find(bufh);
+    return it == g_mock_buffers.end() ? 0 : it->second.size();
+}
+
+uint16_t _buffer_consume(Buffer bufh, uint8_t* into, size_t len) {
+    auto it = g_mock_buffers.find(bufh);
+    if (it == g_mock_buffers.end() || it->second.size() != len) return 8; // NO_SUCH_BYTES
+    std::memcpy(into, it->second.data(), len);
+    g_mock_buffers.erase(it);
+    return 0;
 }
 
 
@@ -212,6 +394,51 @@ uint32_t _bytes_source_get_remaining_count(BytesSource source_handle) {
 }
 
 
+// --- Batched Row Iteration Stubs ---
+// Each mock iterator is a list of BSATN-encoded rows; advance copies as many whole rows as fit.
+static std::vector<uint32_t> g_mock_row_iters_closed;
+static uint32_t g_mock_row_iter_advance_calls = 0;
+// row_iter_bsatn_advance first reports this many empty batches that are not the last.
+static uint32_t g_mock_row_iter_empty_batches = 0;
+
+int16_t row_iter_bsatn_advance(RowIter iter, uint8_t* buffer_ptr, size_t* buffer_len_ptr) {
+    g_mock_row_iter_advance_calls++;
+    auto it = g_mock_row_iters.find(iter.inner);
+    if (it == g_mock_row_iters.end()) {
+        std::cerr << "Error: Invalid RowIter handle in row_iter_bsatn_advance: " << iter.inner << std::endl;
+        return 6; // NO_SUCH_ITER
+    }
+    if (g_mock_row_iter_empty_batches > 0) {
+        g_mock_row_iter_empty_batches--;
+        *buffer_len_ptr = 0;
+        return 0;
+    }
+    size_t& pos = g_mock_row_iters_pos[iter.inner];
+    const auto& rows = it->second;
+    if (pos < rows.size() && rows[pos].size() > *buffer_len_ptr) {
+        *buffer_len_ptr = rows[pos].size();
+        return 11; // BUFFER_TOO_SMALL
+    }
+    size_t written = 0;
+    while (pos < rows.size() && written + rows[pos].size() <= *buffer_len_ptr) {
+        std::memcpy(buffer_ptr + written, rows[pos].data(), rows[pos].size());
+        written += rows[pos].size();
+        pos++;
+    }
+    *buffer_len_ptr = written;
+    if (pos == rows.size()) {
+        g_mock_row_iters.erase(it); // Host destroys exhausted iterators.
+        return -1;
+    }
+    return 0;
+}
+
+uint16_t row_iter_bsatn_close(RowIter iter) {
+    g_mock_row_iters_closed.push_back(iter.inner);
+    return g_mock_row_iters.erase(iter.inner) ? 0 : 6; // NO_SUCH_ITER
+}
+
+
 // Forward declarations for module exported functions (defined in spacetime_module_abi.cpp etc.)
 // This ensures that tests can call these exported functions.
 #ifndef SPACETIMEDB_WASM_EXPORT // Guard for the export macro
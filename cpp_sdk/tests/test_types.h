@@ -0,0 +1,192 @@
+#ifndef SPACETIME_TEST_TYPES_H
+#define SPACETIME_TEST_TYPES_H
+
+#include "spacetimedb/macros.h"                      // For SPACETIMEDB_TYPE_* and SPACETIMEDB_TABLE
+#include "spacetimedb/bsatn/uint128_placeholder.h"   // For SpacetimeDb::Types::uint128_t_placeholder
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Types shared by the unit tests. Each is registered with the module schema like a user type,
+// so the reducer, ModuleDef and table tests see a realistic module.
+namespace SpacetimeDB::Test {
+
+    enum class BasicEnum : uint8_t {
+        ValZero,
+        ValOne,
+        ValTwo
+    };
+
+    struct NestedData {
+        uint32_t item_id = 0;
+        std::string item_name;
+        std::optional<bool> is_active;
+
+        bool operator==(const NestedData&) const = default;
+    };
+
+    struct ComplexType {
+        uint64_t id_field = 0;
+        std::string string_field;
+        SpacetimeDb::Types::uint128_t_placeholder u128_field;
+        BasicEnum enum_field = BasicEnum::ValZero;
+        std::optional<int32_t> opt_i32_field;
+        std::optional<std::string> opt_string_field;
+        std::optional<NestedData> opt_nested_field;
+        std::optional<BasicEnum> opt_enum_field;
+        std::vector<uint8_t> vec_u8_field;
+        std::vector<std::string> vec_string_field;
+        std::vector<NestedData> vec_nested_field;
+        std::vector<BasicEnum> vec_enum_field;
+        std::vector<std::optional<int32_t>> vec_opt_i32_field;
+
+        bool operator==(const ComplexType&) const = default;
+    };
+
+    struct ReducerArgsTestStruct {
+        std::string s_arg;
+        uint64_t u_arg = 0;
+        std::optional<NestedData> opt_nested_arg;
+        std::vector<BasicEnum> vec_enum_arg;
+
+        bool operator==(const ReducerArgsTestStruct&) const = default;
+    };
+
+    // Row of a table with a string primary key.
+    struct KeyedRow {
+        std::string key;
+        uint64_t value = 0;
+
+        bool operator==(const KeyedRow&) const = default;
+    };
+
+    // Row of a table with an auto-increment primary key, a unique column and secondary indexes.
+    struct IndexedRow {
+        uint64_t id = 0;
+        std::string handle;
+        uint32_t x = 0;
+        uint32_t y = 0;
+
+        bool operator==(const IndexedRow&) const = default;
+    };
+
+} // namespace SpacetimeDB::Test
+
+SPACETIMEDB_TYPE_ENUM(SpacetimeDB::Test::BasicEnum, SpacetimeDB_Test_BasicEnum, "BasicEnum", ({
+    SPACETIMEDB_ENUM_VARIANT("ValZero"),
+    SPACETIMEDB_ENUM_VARIANT("ValOne"),
+    SPACETIMEDB_ENUM_VARIANT("ValTwo")
+}))
+
+#define NESTED_DATA_FIELDS(XX, A, B) \
+    XX(A, B, uint32_t, item_id, false, false) \
+    XX(A, B, std::string, item_name, false, false) \
+    XX(A, B, bool, is_active, true, false)
+
+SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS(
+    SpacetimeDB::Test::NestedData, SpacetimeDB_Test_NestedData, "NestedData",
+    NESTED_DATA_FIELDS,
+    ({
+        SPACETIMEDB_FIELD("item_id", SpacetimeDb::CoreType::U32, false, false),
+        SPACETIMEDB_FIELD("item_name", SpacetimeDb::CoreType::String, false, false),
+        SPACETIMEDB_FIELD_OPTIONAL("is_active", SpacetimeDb::CoreType::Bool, false, false)
+    })
+)
+
+#define COMPLEX_TYPE_FIELDS(XX, A, B) \
+    XX(A, B, uint64_t, id_field, false, false) \
+    XX(A, B, std::string, string_field, false, false) \
+    XX(A, B, SpacetimeDb::Types::uint128_t_placeholder, u128_field, false, false) \
+    XX(A, B, SpacetimeDB::Test::BasicEnum, enum_field, false, false) \
+    XX(A, B, int32_t, opt_i32_field, true, false) \
+    XX(A, B, std::string, opt_string_field, true, false) \
+    XX(A, B, SpacetimeDB::Test::NestedData, opt_nested_field, true, false) \
+    XX(A, B, SpacetimeDB::Test::BasicEnum, opt_enum_field, true, false) \
+    XX(A, B, uint8_t, vec_u8_field, false, true) \
+    XX(A, B, std::string, vec_string_field, false, true) \
+    XX(A, B, SpacetimeDB::Test::NestedData, vec_nested_field, false, true) \
+    XX(A, B, SpacetimeDB::Test::BasicEnum, vec_enum_field, false, true) \
+    XX(A, B, std::optional<int32_t>, vec_opt_i32_field, false, true)
+
+SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS(
+    SpacetimeDB::Test::ComplexType, SpacetimeDB_Test_ComplexType, "ComplexType",
+    COMPLEX_TYPE_FIELDS,
+    ({
+        SPACETIMEDB_FIELD("id_field", SpacetimeDb::CoreType::U64, false, false),
+        SPACETIMEDB_FIELD("string_field", SpacetimeDb::CoreType::String, false, false),
+        SPACETIMEDB_FIELD("u128_field", SpacetimeDb::CoreType::U128, false, false),
+        SPACETIMEDB_FIELD_CUSTOM("enum_field", "BasicEnum", false, false),
+        SPACETIMEDB_FIELD_OPTIONAL("opt_i32_field", SpacetimeDb::CoreType::I32, false, false),
+        SPACETIMEDB_FIELD_OPTIONAL("opt_string_field", SpacetimeDb::CoreType::String, false, false),
+        SPACETIMEDB_FIELD_CUSTOM_OPTIONAL("opt_nested_field", "NestedData", false, false),
+        SPACETIMEDB_FIELD_CUSTOM_OPTIONAL("opt_enum_field", "BasicEnum", false, false),
+        SPACETIMEDB_FIELD("vec_u8_field", SpacetimeDb::CoreType::Bytes, false, false),
+        SPACETIMEDB_FIELD("vec_string_field", SpacetimeDb::CoreType::String, false, false),
+        SPACETIMEDB_FIELD_CUSTOM("vec_nested_field", "NestedData", false, false),
+        SPACETIMEDB_FIELD_CUSTOM("vec_enum_field", "BasicEnum", false, false),
+        SPACETIMEDB_FIELD_OPTIONAL("vec_opt_i32_field", SpacetimeDb::CoreType::I32, false, false)
+    })
+)
+
+#define REDUCER_ARGS_TEST_STRUCT_FIELDS(XX, A, B) \
+    XX(A, B, std::string, s_arg, false, false) \
+    XX(A, B, uint64_t, u_arg, false, false) \
+    XX(A, B, SpacetimeDB::Test::NestedData, opt_nested_arg, true, false) \
+    XX(A, B, SpacetimeDB::Test::BasicEnum, vec_enum_arg, false, true)
+
+SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS(
+    SpacetimeDB::Test::ReducerArgsTestStruct, SpacetimeDB_Test_ReducerArgsTestStruct, "TestReducerArgsStruct",
+    REDUCER_ARGS_TEST_STRUCT_FIELDS,
+    ({
+        SPACETIMEDB_FIELD("s_arg", SpacetimeDb::CoreType::String, false, false),
+        SPACETIMEDB_FIELD("u_arg", SpacetimeDb::CoreType::U64, false, false),
+        SPACETIMEDB_FIELD_CUSTOM_OPTIONAL("opt_nested_arg", "NestedData", false, false),
+        SPACETIMEDB_FIELD_CUSTOM("vec_enum_arg", "BasicEnum", false, false)
+    })
+)
+
+#define KEYED_ROW_FIELDS(XX, A, B) \
+    XX(A, B, std::string, key, false, false) \
+    XX(A, B, uint64_t, value, false, false)
+
+SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS(
+    SpacetimeDB::Test::KeyedRow, SpacetimeDB_Test_KeyedRow, "KeyedRow",
+    KEYED_ROW_FIELDS,
+    ({
+        SPACETIMEDB_FIELD("key", SpacetimeDb::CoreType::String, true, false),
+        SPACETIMEDB_FIELD("value", SpacetimeDb::CoreType::U64, false, false)
+    })
+)
+
+#define INDEXED_ROW_FIELDS(XX, A, B) \
+    XX(A, B, uint64_t, id, false, false) \
+    XX(A, B, std::string, handle, false, false) \
+    XX(A, B, uint32_t, x, false, false) \
+    XX(A, B, uint32_t, y, false, false)
+
+SPACETIMEDB_TYPE_STRUCT_WITH_FIELDS(
+    SpacetimeDB::Test::IndexedRow, SpacetimeDB_Test_IndexedRow, "IndexedRow",
+    INDEXED_ROW_FIELDS,
+    ({
+        SPACETIMEDB_FIELD("id", SpacetimeDb::CoreType::U64, false, true),
+        SPACETIMEDB_FIELD("handle", SpacetimeDb::CoreType::String, true, false),
+        SPACETIMEDB_FIELD("x", SpacetimeDb::CoreType::U32, false, false),
+        SPACETIMEDB_FIELD("y", SpacetimeDb::CoreType::U32, false, false)
+    })
+)
+
+SPACETIMEDB_TABLE(SpacetimeDB::Test::NestedData, "MyNestedTable", true)
+SPACETIMEDB_PRIMARY_KEY("MyNestedTable", "item_id")
+SPACETIMEDB_TABLE(SpacetimeDB::Test::KeyedRow, "AnotherTableUnit", false)
+SPACETIMEDB_PRIMARY_KEY("AnotherTableUnit", "key")
+SPACETIMEDB_TABLE(SpacetimeDB::Test::IndexedRow, "IndexedTable", false)
+SPACETIMEDB_PRIMARY_KEY("IndexedTable", "id")
+SPACETIMEDB_INDEX("IndexedTable", "by_x", {"x"})
+SPACETIMEDB_INDEX("IndexedTable", "by_xy", {"x", "y"})
+SPACETIMEDB_INDEX_DIRECT("IndexedTable", "by_y", "y")
+// An index on exactly the unique column stands in for its backing btree index.
+SPACETIMEDB_INDEX_HASH("IndexedTable", "by_handle", {"handle"})
+
+#endif // SPACETIME_TEST_TYPES_H
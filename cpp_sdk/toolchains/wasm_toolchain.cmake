@@ -64,8 +64,18 @@ set(CMAKE_EXECUTABLE_SUFFIX ".wasm")
 # --no-entry: For side modules that don't have a main() entry point in the C/C++ sense.
 # -Wall -Wextra: Good general warnings.
 set(COMMON_WASM_FLAGS "-O2 -s SIDE_MODULE=1 -s STRICT=1 --no-entry -Wall -Wextra")
+
+# -DSPACETIMEDB_NO_EXCEPTIONS=ON builds the module and the SDK without C++ exceptions.
+# SDK calls then report failures through their try_ variants (Result / status types) and
+# reducers fail by returning a ReducerResult error; see spacetimedb/sdk/result.h.
+option(SPACETIMEDB_NO_EXCEPTIONS "Build the module and the SpacetimeDB C++ SDK with -fno-exceptions" OFF)
+set(WASM_CXX_FLAGS "${COMMON_WASM_FLAGS}")
+if(SPACETIMEDB_NO_EXCEPTIONS)
+    string(APPEND WASM_CXX_FLAGS " -fno-exceptions -DSPACETIMEDB_NO_EXCEPTIONS")
+endif()
+
 set(CMAKE_C_FLAGS_INIT "${COMMON_WASM_FLAGS}" CACHE STRING "Initial C flags for WASM" FORCE)
-set(CMAKE_CXX_FLAGS_INIT "${COMMON_WASM_FLAGS}" CACHE STRING "Initial CXX flags for WASM" FORCE)
+set(CMAKE_CXX_FLAGS_INIT "${WASM_CXX_FLAGS}" CACHE STRING "Initial CXX flags for WASM" FORCE)
 
 # Linker flags
 # --no-entry is also important for the linker for side modules.